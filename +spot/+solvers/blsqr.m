@@ -0,0 +1,220 @@
+function [ X, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm ]...
+  = blsqr( m, n, A, B, damp, atol, btol, conlim, itnlim, show )
+%
+%        [ X, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm ]...
+% = blsqr( m, n, A, B, damp, atol, btol, conlim, itnlim, show );
+%
+% BLSQR applies LSQR to all columns of B at once. Every column has its
+% own Golub-Kahan bidiagonalization, but the recurrences are advanced
+% together so that each iteration applies A and A' only once, to the
+% block of vectors of all columns that have not yet converged. When A
+% is an operator that supports sweep products this gives one batched
+% product per iteration instead of one product per right-hand side.
+% Function handles are applied to one column at a time.
+%
+% Columns are removed from the block (deflated) as soon as they satisfy
+% the stopping criteria of LSQR. The input parameters are as for
+% spot.solvers.lsqr. The output parameters are the same as well, except
+% that X has one column per column of B and all others are row vectors
+% with the value for each column. The variance estimate is not
+% available.
+%
+% See also spot.solvers.lsqr.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+%     Initialize.
+
+explicit = isnumeric(A) | issparse(A) | ismethod(A,'mtimes');
+p = size(B,2);
+
+if show
+   disp(' ')
+   disp('BLSQR           Least-squares solution of  AX = B')
+   str1 = sprintf('The matrix A has %8g rows  and %8g cols', m, n);
+   str2 = sprintf('damp = %20.14e    nrhs = %8g', damp, p);
+   str3 = sprintf('atol = %8.2e                 conlim = %8.2e', atol, conlim);
+   str4 = sprintf('btol = %8.2e                 itnlim = %8g'  , btol, itnlim);
+   disp(str1);   disp(str2);   disp(str3);   disp(str4);
+end
+
+X      = zeros(n,p);
+istop  = zeros(1,p);     itn    = zeros(1,p);
+ctol   = 0;              if conlim > 0, ctol = 1/conlim; end;
+anorm  = zeros(1,p);     acond  = zeros(1,p);
+dampsq = damp^2;         ddnorm = zeros(1,p);   res2 = zeros(1,p);
+xnorm  = zeros(1,p);     xxnorm = zeros(1,p);   z    = zeros(1,p);
+cs2    = -ones(1,p);     sn2    = zeros(1,p);
+
+% Set up the first vectors u and v for the bidiagonalization.
+% These satisfy  beta*u = b,  alfa*v = A'u  for each column.
+
+U      = B(1:m,:);       V    = zeros(n,p);
+alfa   = zeros(1,p);     beta = colnorm(U);
+k      = find(beta > 0);
+if ~isempty(k)
+   U(:,k) = scale(U(:,k),1./beta(k));
+   V(:,k) = Aprod(U(:,k),2);
+   alfa(k)= colnorm(V(:,k));
+end
+k      = find(alfa > 0);
+V(:,k) = scale(V(:,k),1./alfa(k));
+W      = V;
+
+arnorm = alfa .* beta;
+rhobar = alfa;           phibar = beta;         bnorm  = beta;
+r1norm = beta;           r2norm = beta;
+
+% Columns with arnorm = 0 have the exact solution x = 0.
+active = find(arnorm ~= 0);
+
+%------------------------------------------------------------------
+%     Main iteration loop.
+%------------------------------------------------------------------
+it = 0;
+while ~isempty(active) && it < itnlim
+      it = it + 1;
+      a  = active;
+
+%     Perform the next step of the bidiagonalization to obtain the
+%     next  beta, u, alfa, v  for all active columns.
+
+      U(:,a)  = Aprod(V(:,a),1) - scale(U(:,a),alfa(a));
+      beta(a) = colnorm(U(:,a));
+      g       = a(beta(a) > 0);
+      if ~isempty(g)
+         U(:,g)   = scale(U(:,g),1./beta(g));
+         anorm(g) = sqrt(anorm(g).^2 + alfa(g).^2 + beta(g).^2 + dampsq);
+         V(:,g)   = Aprod(U(:,g),2) - scale(V(:,g),beta(g));
+         alfa(g)  = colnorm(V(:,g));
+         h        = g(alfa(g) > 0);
+         V(:,h)   = scale(V(:,h),1./alfa(h));
+      end
+
+%     Use a plane rotation to eliminate the damping parameter.
+
+      rhobar1 = sqrt(rhobar(a).^2 + dampsq);
+      cs1     = rhobar(a) ./ rhobar1;
+      sn1     = damp      ./ rhobar1;
+      psi     = sn1 .* phibar(a);
+      phibar(a) = cs1 .* phibar(a);
+
+%     Use a plane rotation to eliminate the subdiagonal element (beta).
+
+      rho     = sqrt(rhobar1.^2 + beta(a).^2);
+      cs      =   rhobar1 ./ rho;
+      sn      =   beta(a) ./ rho;
+      theta   =   sn .* alfa(a);
+      rhobar(a) = - cs .* alfa(a);
+      phi     =   cs .* phibar(a);
+      phibar(a) = sn .* phibar(a);
+      tau     =   sn .* phi;
+
+%     Update x and w.
+
+      t1      =   phi   ./ rho;
+      t2      = - theta ./ rho;
+      Dk      =   scale(W(:,a),1./rho);
+
+      X(:,a)  = X(:,a) + scale(W(:,a),t1);
+      W(:,a)  = V(:,a) + scale(W(:,a),t2);
+      ddnorm(a) = ddnorm(a) + colnorm(Dk).^2;
+
+%     Use a plane rotation on the right to eliminate the
+%     super-diagonal element (theta) and estimate norm(x).
+
+      delta   =   sn2(a) .* rho;
+      gambar  = - cs2(a) .* rho;
+      rhs     =   phi - delta .* z(a);
+      zbar    =   rhs ./ gambar;
+      xnorm(a)=   sqrt(xxnorm(a) + zbar.^2);
+      gamma   =   sqrt(gambar.^2 + theta.^2);
+      cs2(a)  =   gambar ./ gamma;
+      sn2(a)  =   theta  ./ gamma;
+      z(a)    =   rhs    ./ gamma;
+      xxnorm(a) = xxnorm(a) + z(a).^2;
+
+%     Test for convergence.
+
+      acond(a)  = anorm(a) .* sqrt(ddnorm(a));
+      res1      = phibar(a).^2;
+      res2(a)   = res2(a) + psi.^2;
+      rnorm     = sqrt(res1 + res2(a));
+      arnorm(a) = alfa(a) .* abs(tau);
+
+      r1sq      = rnorm.^2 - dampsq * xxnorm(a);
+      r1norm(a) = sign(r1sq) .* sqrt(abs(r1sq));
+      r2norm(a) = rnorm;
+
+      test1   =   rnorm ./ bnorm(a);
+      test2   =   arnorm(a) ./ (anorm(a) .* rnorm);
+      test3   =   1 ./ acond(a);
+      t1      =   test1 ./ (1 + anorm(a) .* xnorm(a) ./ bnorm(a));
+      rtol    =   btol + atol * anorm(a) .* xnorm(a) ./ bnorm(a);
+
+      s = zeros(size(a));
+      if it >= itnlim, s(:) = 7; end
+      s(1 + test3 <= 1) = 6;
+      s(1 + test2 <= 1) = 5;
+      s(1 + t1    <= 1) = 4;
+      s(test3 <= ctol)  = 3;
+      s(test2 <= atol)  = 2;
+      s(test1 <= rtol)  = 1;
+
+      istop(a) = s;
+      itn(a)   = it;
+
+      if show && (it <= 10 || rem(it,10) == 0 || any(s ~= 0))
+         str1 = sprintf( '%6g %8g',           it, length(a) );
+         str2 = sprintf( ' %10.3e %10.3e', max(r1norm(a)), max(r2norm(a)) );
+         str3 = sprintf( '  %8.1e %8.1e',  max(test1), max(test2) );
+         disp([str1 str2 str3])
+      end
+
+%     Deflate the converged columns.
+
+      active = a(s == 0);
+end
+
+if show
+   disp(' ')
+   disp('BLSQR finished')
+   str1 = sprintf( 'itn   =%8g   converged =%8g', it, nnz(istop > 0) );
+   str2 = sprintf( 'max r1norm =%8.1e', max([0 r1norm]) );
+   disp([str1 '   ' str2])
+   disp(' ')
+end
+
+%-----------------------------------------------------------------------
+% End of blsqr.m
+%-----------------------------------------------------------------------
+
+function Z = Aprod(X,mode)
+   if explicit
+      if mode == 1, Z = A*X;
+      else          Z = (X'*A)';
+      end
+   else
+      % Function handles are applied one column at a time.
+      if mode == 1, Z = zeros(m,size(X,2));
+      else          Z = zeros(n,size(X,2));
+      end
+      for j=1:size(X,2)
+         Z(:,j) = A(X(:,j),mode);
+      end
+   end
+end % function Aprod
+
+end
+
+function r = colnorm(X)
+   r = sqrt(sum(abs(X).^2,1));
+end
+
+function X = scale(X,s)
+   X = bsxfun(@times,X,s);
+end
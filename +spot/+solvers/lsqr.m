@@ -7,6 +7,9 @@ function [ x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm, var ]...
 % LSQR solves  Ax = b  or  min ||b - Ax||_2  if damp = 0,
 % or   min || (b)  -  (  A   )x ||   otherwise.
 %          || (0)     (damp I)  ||2
+% When b has several columns, all of them are solved together by
+% spot.solvers.blsqr and the outputs other than x are row vectors.
+%
 % A  is an m by n matrix defined or a function handle of aprod( mode,x ),
 % that performs the matrix-vector operations.
 % If mode = 1,   aprod  must return  y = Ax   without altering x.
@@ -78,6 +81,16 @@ function [ x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm, var ]...
 %              Ewout van den Berg, University of British Columbia
 %-----------------------------------------------------------------------
 
+%     Several right-hand sides are solved together.
+
+if size(b,2) > 1
+   out = cell(1,9);
+   [out{:}] = spot.solvers.blsqr(m,n,A,b,damp,atol,btol,conlim,itnlim,show);
+   [x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm] = out{:};
+   var = [];
+   return
+end
+
 %     Initialize.
 
 msg=['The exact solution is  x = 0                              '
@@ -0,0 +1,192 @@
+function [ x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm ]...
+  = mplsqr( m, n, A, b, damp, atol, btol, conlim, itnlim, show )
+%
+%        [ x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm ]...
+% = mplsqr( m, n, A, b, damp, atol, btol, conlim, itnlim, show );
+%
+% MPLSQR is a mixed-precision version of spot.solvers.lsqr. The inner
+% LSQR iterations apply A in single precision to a correction problem
+%
+%      minimize || A*d - r ||_2,   r = b - A*x,
+%
+% and an outer refinement loop updates x and recomputes the residual
+% in double precision, until x satisfies the LSQR stopping tests with
+% the requested tolerances. Because the bulk of the products are done
+% in single precision, operators whose products are limited by memory
+% bandwidth are applied nearly twice as fast.
+%
+% A must be a matrix or a Spot operator. When products with A cannot be
+% done in single precision (they raise an error or do not return single
+% precision results) or when damp > 0, the call is handed to
+% spot.solvers.lsqr unchanged. The outcome of the check is stored with
+% the operator, so that it is done only once. For a dense opMatrix a
+% single-precision copy of the matrix is also stored with the operator
+% and used by the inner solves. Other operators that keep their data in
+% double precision pass the check but convert it on every product, and
+% gain little from this solver.
+%
+% The input and output parameters are as for spot.solvers.lsqr. ITN is
+% the total number of inner iterations, and ANORM and ACOND are the
+% estimates from the inner solves. When b has several columns the
+% outputs other than x are row vectors, as for spot.solvers.blsqr.
+%
+% See also spot.solvers.lsqr, spot.solvers.blsqr, spotparams.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   maxref = 20;              % Maximum number of refinement steps
+   intol  = sqrt(eps('single'));
+
+   if damp ~= 0 || ~canSingle_intrnl(A,n)
+      [x, istop, itn, r1norm, r2norm, anorm, acond, arnorm, xnorm] = ...
+         spot.solvers.lsqr(m,n,A,b,damp,atol,btol,conlim,itnlim,show);
+      return
+   end
+
+   % Single-precision products with A. Explicit matrices, given
+   % directly or through opMatrix, are converted once, so that the
+   % inner products read single-precision data.
+   As = singleMatrix_intrnl(A);
+   if ~isempty(As)
+      fun = @(x,mode) singleProd_intrnl(As,x,mode);
+   else
+      fun = @(x,mode) singleProd_intrnl(A,x,mode);
+   end
+
+   p      = size(b,2);
+   x      = zeros(n,p);
+   r      = b;
+   bnorm  = colnorm(b);
+   istop  = zeros(1,p);
+   itn    = 0;
+   anorm  = zeros(1,p);      acond = zeros(1,p);
+   active = find(bnorm > 0);
+
+   if show
+      disp(' ')
+      disp('MPLSQR          Mixed-precision least-squares solution of  Ax = b')
+      disp('   Ref      Itn     r1norm     arnorm')
+   end
+
+   for ref=1:maxref
+      if isempty(active) || itn >= itnlim, break, end
+
+      % Inner solve in single precision.
+      [d,s,it,~,~,an,ac] = spot.solvers.lsqr(m,n,fun,single(r(:,active)), ...
+                              0,intol,intol,conlim,itnlim-itn,0);
+      itn = itn + max(it);
+      anorm(active) = max(anorm(active),double(an));
+      acond(active) = max(acond(active),double(ac));
+
+      % Refinement in double precision.
+      x(:,active) = x(:,active) + double(d);
+      r(:,active) = b(:,active) - A*x(:,active);
+      Ar     = A'*r(:,active);
+      rn     = colnorm(r(:,active));
+      arn    = colnorm(Ar);
+      xn     = colnorm(x(:,active));
+
+      test1  = rn ./ bnorm(active);
+      test2  = arn ./ (anorm(active) .* rn);
+      rtol   = btol + atol * anorm(active) .* xn ./ bnorm(active);
+
+      st = zeros(size(active));
+      st(s == 3 | s == 6) = 3;       % Condition limit of the inner solve
+      st(test2 <= atol)   = 2;
+      st(test1 <= rtol)   = 1;
+      istop(active) = st;
+
+      if show
+         disp(sprintf('%6g %8g %10.3e %10.3e',ref,itn,max(rn),max(arn)));
+      end
+
+      % Stop columns that converged or for which the inner solve made
+      % no progress.
+      active = active(st == 0 & it > 0);
+   end
+   istop(active) = 7;
+
+   r1norm = colnorm(r);
+   r2norm = r1norm;
+   arnorm = colnorm(A'*r);
+   xnorm  = colnorm(x);
+end % function mplsqr
+
+
+%=======================================================================
+
+
+function ok = canSingle_intrnl(A,n)
+% Check whether products with A can be done in single precision.
+
+   if isnumeric(A)
+      ok = isfloat(A) && ~issparse(A);
+      return
+   end
+   if ~isa(A,'opSpot')
+      ok = false;
+      return
+   end
+
+   cache = A.counter.cache;
+   if isfield(cache,'single')
+      ok = cache.single;
+      return
+   end
+
+   try
+      y  = A*ones(n,1,'single');
+      ok = isa(y,'single') && all(isfinite(y(:)));
+   catch
+      ok = false;
+   end
+   c = A.counter;
+   c.cache.single = ok;
+end
+
+
+%=======================================================================
+
+
+function As = singleMatrix_intrnl(A)
+% Single-precision copy of an explicit matrix, or [] for other operators.
+% The copy of an opMatrix is kept in the operator cache.
+
+   As = [];
+   if isnumeric(A)
+      As = single(A);
+   elseif isa(A,'opMatrix') && isfloat(A.matrix) && ~issparse(A.matrix)
+      cache = A.counter.cache;
+      if isfield(cache,'singlematrix')
+         As = cache.singlematrix;
+      else
+         As = single(A.matrix);
+         c = A.counter;
+         c.cache.singlematrix = As;
+      end
+   end
+end
+
+
+%=======================================================================
+
+
+function y = singleProd_intrnl(A,x,mode)
+   if mode == 1
+      y = single(A*single(x));
+   else
+      y = single(A'*single(x));
+   end
+end
+
+
+%=======================================================================
+
+
+function r = colnorm(X)
+   r = sqrt(sum(abs(X).^2,1));
+end
@@ -0,0 +1,124 @@
+function y = applyChildren(ops,x,mode)
+%applyChildren  Apply a list of operators, concurrently if enabled.
+%
+%   Y = applyChildren(OPS,X,MODE) returns a cell array with Y{i} equal to
+%   OPS{i}*X{i} when MODE is 1, and OPS{i}'*X{i} when MODE is 2. When X
+%   is not a cell array the same input is passed to every operator.
+%
+%   The products are evaluated according to spotparams('parallel'):
+%
+%   'off'        all products are evaluated in turn in the client.
+%   'threads'    products are submitted to the background thread pool.
+%   'processes'  products are submitted to the current parallel pool.
+%
+%   Scheduling is based on the average time per product recorded in
+%   the counter of each operator. Operators whose products take less
+%   than spotparams('parmincost') seconds are evaluated in the client
+%   while the remaining ones run on the pool; the most expensive ones
+%   are submitted first. Operators without timing information are
+%   considered expensive. When no pool is available, or fewer than two
+%   products would be submitted, all products are evaluated serially.
+%
+%   See also spotparams, spot.counter.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   nops = length(ops);
+   if ~iscell(x)
+      x = repmat({x},1,nops);
+   end
+   y = cell(1,nops);
+
+   % Estimated cost of each product; unknown costs go to the pool.
+   cost = zeros(1,nops);
+   for i=1:nops
+      cost(i) = ops{i}.counter.cost(mode);
+   end
+   cost(isnan(cost)) = Inf;
+
+   remote = cost >= spotparams('parmincost');
+   pool   = [];
+   if nnz(remote) >= 2
+      pool = spot.utils.getPool();
+   end
+
+   if isempty(pool)
+      % Serial evaluation
+      for i=1:nops
+         y{i} = applyTimed_intrnl(ops{i},x{i},mode);
+      end
+      return
+   end
+
+   % Submit the expensive products, largest first.
+   idx = find(remote);
+   [~,order] = sort(cost(idx),'descend');
+   idx = idx(order);
+   futures = cell(1,length(idx));
+   for k=1:length(idx)
+      i = idx(k);
+      futures{k} = parfeval(pool,@remoteApply_intrnl,2,ops{i},x{i},mode);
+   end
+
+   % Cheap products are evaluated while the pool is busy.
+   for i=find(~remote)
+      y{i} = applyTimed_intrnl(ops{i},x{i},mode);
+   end
+
+   % Collect the results. Products on the workers were counted on
+   % copies of the counters, so the client counters are updated here.
+   for k=1:length(idx)
+      i = idx(k);
+      try
+         [y{i},t] = fetchOutputs(futures{k});
+         ops{i}.counter.plus1(mode);
+         ops{i}.counter.addtime(mode,t);
+         if spotparams('profile')
+            ops{i}.counter.addio(mode,x{i},y{i});
+         end
+      catch
+         % Operators that cannot run on the pool are applied locally.
+         y{i} = applyTimed_intrnl(ops{i},x{i},mode);
+      end
+   end
+end % function applyChildren
+
+
+%=======================================================================
+
+
+function y = applyTimed_intrnl(op,x,mode)
+% Apply op to x in the client and record the elapsed time.
+
+   t = tic;
+   if mode == 1
+      y = op * x;
+   else
+      y = op' * x;
+   end
+   if ~(spotparams('profile') || ...
+        (spotparams('promote') && ~isempty(op.children)))
+      % Otherwise the product was already timed by applyMultiply.
+      op.counter.addtime(mode,toc(t));
+   end
+end
+
+
+%=======================================================================
+
+
+function [y,t] = remoteApply_intrnl(op,x,mode)
+% Apply op to x on a worker and return the elapsed time.
+
+   t = tic;
+   if mode == 1
+      y = op * x;
+   else
+      y = op' * x;
+   end
+   t = toc(t);
+end
@@ -0,0 +1,33 @@
+function y = dctexec(plan,x,mode)
+%dctexec  Real-to-real DCT using a precomputed plan.
+%
+%   Y = dctexec(PLAN,X,1) computes the orthonormal DCT-II of each
+%   column of X, and Y = dctexec(PLAN,X,2) computes the inverse
+%   (DCT-III). PLAN is obtained from spot.utils.dctplan(size(X,1)).
+%
+%   Each transform uses one FFT of length N on the permuted input and
+%   the real part of the twiddled result; no length-2N temporaries are
+%   formed. Complex input is handled by transforming the real and
+%   imaginary parts separately.
+%
+%   See also spot.utils.dctplan.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   x = full(x);
+   if ~isreal(x)
+      y = dctexec(plan,real(x),mode) + 1i*dctexec(plan,imag(x),mode);
+      return
+   end
+
+   if mode == 1
+      y = real(bsxfun(@times,plan.wf,fft(x(plan.idx,:),[],1)));
+   else
+      y = x;
+      y(plan.idx,:) = real(ifft(bsxfun(@times,plan.wi,x),[],1));
+   end
+end
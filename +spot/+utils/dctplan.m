@@ -0,0 +1,47 @@
+function plan = dctplan(n)
+%dctplan  Precomputed weights for the real-to-real DCT.
+%
+%   PLAN = dctplan(N) returns the permutation and twiddle factors used
+%   by spot.utils.dctexec to compute the orthonormal DCT-II (and its
+%   inverse, the DCT-III) of vectors of length N with a single FFT of
+%   length N. Plans are cached, so requesting the same size again does
+%   not recompute the weights.
+%
+%   dctplan('clear') empties the plan cache.
+%
+%   See also spot.utils.dctexec, spot.utils.dct, spot.utils.idct.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   persistent cache
+   if isempty(cache) || (ischar(n) && strcmpi(n,'clear'))
+      cache = containers.Map('KeyType','double','ValueType','any');
+      if ischar(n), plan = []; return; end
+   end
+
+   if isKey(cache,n)
+      plan = cache(n);
+      return
+   end
+
+   % Makhoul's reordering: even-indexed entries first, followed by the
+   % odd-indexed entries in reverse order. This holds for any n.
+   k = (0:n-1)';
+   plan.n   = n;
+   plan.idx = [1:2:n, 2*floor(n/2):-2:2]';
+
+   % Forward (DCT-II) and inverse (DCT-III) weights, including the
+   % orthonormal scaling.
+   plan.wf  = [sqrt(1/n); sqrt(2/n)*ones(n-1,1)] .* exp((-1i*pi/2/n)*k);
+   plan.wi  = [sqrt(n);   sqrt(2*n)*ones(n-1,1)] .* exp(( 1i*pi/2/n)*k);
+
+   % Keep the cache bounded.
+   if cache.Count >= 64
+      cache = containers.Map('KeyType','double','ValueType','any');
+   end
+   cache(n) = plan;
+end
@@ -0,0 +1,167 @@
+function varargout = diskcache(name,key,fun,nout)
+%diskcache  Reuse precomputed operator data stored on disk.
+%
+%   [OUT1,OUT2,...] = diskcache(NAME,KEY,FUN) returns the outputs of
+%   FUN(), a function handle without arguments. When the parameter
+%   spotparams('cachedir') is set, the outputs are stored in that
+%   directory under a name derived from NAME and a SHA-256 hash of KEY,
+%   and later calls with the same NAME and KEY load them from the file
+%   instead of calling FUN. KEY must hold everything the outputs depend
+%   on, such as the constructor arguments and the RNG state; it may be
+%   any combination of numeric, logical and character arrays, cell
+%   arrays, structs and function handles.
+%
+%   The outputs are only stored when FUN takes at least
+%   spotparams('cachemintime') seconds. Each file is written under a
+%   temporary name and then renamed, so that workers sharing the
+%   directory never load an incomplete file. Files that cannot be read
+%   or written are silently recomputed; the cache can be cleared at any
+%   time by deleting the directory.
+%
+%   [OUT1,...,OUTN,HIT] = diskcache(NAME,KEY,FUN,N) also returns HIT,
+%   which is true when the N outputs of FUN were loaded from the cache
+%   rather than computed. Callers use it to replay side effects of FUN,
+%   such as the RNG state after a random matrix is generated.
+%
+%   Example: share the setup of operators between batch workers:
+%
+%       spotparams('cachedir',fullfile(tempdir,'spotcache'));
+%       A = opGaussian(2000,10000);  % Generated and stored
+%       A = opGaussian(2000,10000);  % Loaded from the cache
+%
+%   See also spotparams.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   if nargin < 4
+      nout = max(1,nargout);
+   else
+      varargout{nout+1} = false;   % Hit flag
+   end
+   cachedir = spotparams('cachedir');
+   hash = '';
+   if ~isempty(cachedir)
+      hash = hash_intrnl({name,key});
+   end
+   if isempty(hash)
+      [varargout{1:nout}] = fun();
+      return
+   end
+   file = fullfile(cachedir,sprintf('%s_%s.mat',name,hash));
+
+   % Load the outputs if they were stored before.
+   if exist(file,'file')
+      try
+         S = load(file,'out');
+         if iscell(S.out) && numel(S.out) >= nout
+            varargout(1:nout) = S.out(1:nout);
+            if nargin >= 4, varargout{nout+1} = true; end
+            return
+         end
+      catch
+         % Unreadable file; recompute and overwrite it.
+      end
+   end
+
+   t = tic;
+   [varargout{1:nout}] = fun();
+   if toc(t) < spotparams('cachemintime')
+      return
+   end
+
+   % Store the outputs.
+   out = varargout(1:nout);
+   tmp = '';
+   try
+      if ~exist(cachedir,'dir'), mkdir(cachedir); end
+      tmp = [tempname(cachedir) '.mat'];
+      info = whos('out');
+      if info.bytes < 2^31
+         save(tmp,'out','-v6');      % Uncompressed, fastest to load
+      else
+         save(tmp,'out','-v7.3');
+      end
+      movefile(tmp,file,'f');
+   catch
+      if ~isempty(tmp) && exist(tmp,'file'), delete(tmp); end
+   end
+end % function diskcache
+
+
+%=======================================================================
+
+
+function hash = hash_intrnl(key)
+% SHA-256 hash of the key, together with the Spot version, as a string
+% of hexadecimal digits. Returns '' when the key cannot be hashed.
+
+   persistent version
+   if isempty(version)
+      try
+         version = fileread(fullfile(spot.path,'VERSION'));
+      catch
+         version = '';
+      end
+   end
+
+   try
+      md = java.security.MessageDigest.getInstance('SHA-256');
+      md.update(uint8(version));
+      if ~update_intrnl(md,key)
+         hash = '';
+         return
+      end
+      hash = typecast(md.digest(),'uint8');
+      hash = lower(reshape(dec2hex(hash,2)',1,[]));
+   catch
+      hash = '';
+   end
+end
+
+
+%=======================================================================
+
+
+function ok = update_intrnl(md,v)
+% Add the class, size and contents of v to the digest.
+
+   ok = true;
+   md.update(uint8(sprintf('%s[%s]',class(v),num2str(size(v)))));
+   if issparse(v)
+      [i,j,s] = find(v);
+      ok = update_intrnl(md,{i,j,full(s)});
+   elseif isnumeric(v) || islogical(v) || ischar(v)
+      if islogical(v) || ischar(v)
+         v = uint16(v);
+      end
+      if isreal(v)
+         bytes = typecast(v(:),'uint8');
+      else
+         bytes = [typecast(real(v(:)),'uint8'); typecast(imag(v(:)),'uint8')];
+      end
+      if ~isempty(bytes)
+         md.update(bytes);
+      end
+   elseif iscell(v)
+      for k=1:numel(v)
+         if ~update_intrnl(md,v{k}), ok = false; return, end
+      end
+   elseif isstruct(v)
+      f = sort(fieldnames(v));
+      ok = update_intrnl(md,f');
+      for k=1:numel(v)
+         for l=1:length(f)
+            if ~ok, return, end
+            ok = update_intrnl(md,v(k).(f{l}));
+         end
+      end
+   elseif isa(v,'function_handle')
+      ok = update_intrnl(md,func2str(v));
+   else
+      ok = false;
+   end
+end
@@ -4,6 +4,8 @@ function c = fdct_c2v(x,cn)
 %   FDCT_C2V(X,CN) returns a vector of length CN containing
 %   the curvelet coefficients contained in X. When parameter
 %   CN is omitted the vector length is determined from X.
+%
+%   FDCT_C2V(X,L) uses the layout L given by FDCT_LAYOUT.
 
 %   Copyright 2008, Gilles Hennenfent, Ewout van den Berg, Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -11,6 +13,16 @@ function c = fdct_c2v(x,cn)
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
+% Copy the wedges using a precomputed layout
+if nargin == 2 && isstruct(cn)
+  L = cn;
+  c = zeros(L.offset(end),1);
+  for k = 1:L.count
+     c(L.offset(k)+1:L.offset(k+1)) = x{L.scale(k)}{L.wedge(k)};
+  end
+  return
+end
+
 % If vector size is not give, determine from coefficients
 if nargin < 2
   cn = 0;
@@ -0,0 +1,57 @@
+function L = fdct_layout(x)
+% FDCT_LAYOUT  Offset table of curvelet coefficients in vector form
+%
+%   L = FDCT_LAYOUT(X) returns the layout of the curvelet coefficient
+%   structure X in the vector returned by FDCT_C2V. The wedges are
+%   numbered consecutively over all scales, and wedge K occupies
+%   entries L.offset(K)+1 through L.offset(K+1) of the vector. The
+%   structure L has the fields:
+%
+%     count    number of wedges
+%     scale    scale of each wedge
+%     wedge    index of each wedge within its scale
+%     dims     size of the coefficient array of each wedge
+%     offset   offset of each wedge in the vector (count+1 entries)
+%     pair     index of the opposite wedge, which holds the imaginary
+%              part in the real-valued transform, or 0 for scales that
+%              consist of a single wedge.
+%
+%   The layout can be passed to FDCT_C2V and FDCT_V2C in place of the
+%   sizes, which avoids recomputing it on every conversion.
+
+%   Copyright 2009, Gilles Hennenfent, Ewout van den Berg, Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+count = 0;
+for i = 1:length(x)
+   count = count + length(x{i});
+end
+
+L.count  = count;
+L.scale  = zeros(count,1);
+L.wedge  = zeros(count,1);
+L.dims   = zeros(count,2);
+L.offset = zeros(count+1,1);
+L.pair   = zeros(count,1);
+
+k = 0;
+for i = 1:length(x)
+   nw = length(x{i});
+   for j = 1:nw
+      k = k + 1;
+      L.scale(k)    = i;
+      L.wedge(k)    = j;
+      L.dims(k,:)   = size(x{i}{j});
+      L.offset(k+1) = L.offset(k) + numel(x{i}{j});
+      if nw > 1
+         if j <= nw/2
+            L.pair(k) = k + nw/2;
+         else
+            L.pair(k) = k - nw/2;
+         end
+      end
+   end
+end
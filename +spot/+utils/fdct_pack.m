@@ -0,0 +1,31 @@
+function y = fdct_pack(x,L)
+% FDCT_PACK  Complex curvelet coefficients to real-valued vector
+%
+%   FDCT_PACK(X,L) returns the vector FDCT_C2V(FDCT_WRAPPING_C2R(X),L)
+%   in a single pass over the coefficients X, using the layout L given
+%   by FDCT_LAYOUT. The real and imaginary parts of each wedge in the
+%   first half of a scale, scaled by sqrt(2), are stored in place of
+%   that wedge and of the opposite wedge. Scales consisting of a single
+%   wedge keep the real part only.
+%
+%   See also FDCT_UNPACK, FDCT_LAYOUT.
+
+%   Copyright 2009, Gilles Hennenfent, Ewout van den Berg, Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+y = zeros(L.offset(end),1);
+s = sqrt(2);
+for k = 1:L.count
+   p = L.pair(k);
+   if p == 0
+      A = x{L.scale(k)}{L.wedge(k)};
+      y(L.offset(k)+1:L.offset(k+1)) = real(A(:));
+   elseif p > k
+      A = x{L.scale(k)}{L.wedge(k)};
+      y(L.offset(k)+1:L.offset(k+1)) = s*real(A(:));
+      y(L.offset(p)+1:L.offset(p+1)) = s*imag(A(:));
+   end
+end
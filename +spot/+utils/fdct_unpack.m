@@ -0,0 +1,28 @@
+function v = fdct_unpack(x,L)
+% FDCT_UNPACK  Real-valued vector to complex curvelet coefficients
+%
+%   FDCT_UNPACK(X,L) is the inverse of FDCT_PACK, and returns
+%   FDCT_WRAPPING_R2C(FDCT_V2C(X,L)) in a single pass over X. The
+%   coefficients of opposite wedges are complex conjugates.
+%
+%   See also FDCT_PACK, FDCT_LAYOUT.
+
+%   Copyright 2009, Gilles Hennenfent, Ewout van den Berg, Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+v = cell(1,max(L.scale));
+s = 1/sqrt(2);
+for k = 1:L.count
+   p = L.pair(k);
+   a = x(L.offset(k)+1:L.offset(k+1));
+   if p == 0
+      v{L.scale(k)}{L.wedge(k)} = reshape(a,L.dims(k,:));
+   elseif p > k
+      b = x(L.offset(p)+1:L.offset(p+1));
+      v{L.scale(k)}{L.wedge(k)} = reshape(s*(a + 1i*b),L.dims(k,:));
+      v{L.scale(p)}{L.wedge(p)} = reshape(s*(a - 1i*b),L.dims(p,:));
+   end
+end
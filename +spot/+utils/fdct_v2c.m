@@ -6,6 +6,8 @@ function v = fdct_v2c(x,hdr,ac,nba)
 %   NBA respectively give the size of the coefficients on each
 %   level, the treatment of the finest level (e.g. AC=2 for
 %   wavelets), and the number of angles.
+%
+%   FDCT_V2C(X,L) uses the layout L given by FDCT_LAYOUT instead.
 
 %   Copyright 2008, Gilles Hennenfent and Ewout van den Berg, Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -13,6 +15,17 @@ function v = fdct_v2c(x,hdr,ac,nba)
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
+% Extract the wedges using a precomputed layout
+if nargin == 2 && isstruct(hdr)
+   L = hdr;
+   v = cell(1,max(L.scale));
+   for k = 1:L.count
+      v{L.scale(k)}{L.wedge(k)} = ...
+         reshape(x(L.offset(k)+1:L.offset(k+1)),L.dims(k,:));
+   end
+   return
+end
+
 k = prod(hdr{1}{1});
 v{1}{1} = reshape(x(1:k),hdr{1}{1});
 for i=2:length(hdr)+1-ac
@@ -0,0 +1,37 @@
+function pool = getPool(type)
+%getPool  Pool used for concurrent evaluation.
+%
+%   POOL = getPool(TYPE) returns the pool for the parallel mode TYPE,
+%   one of the values of spotparams('parallel'):
+%
+%   'off'        no pool;
+%   'threads'    the background thread pool;
+%   'processes'  the current parallel pool, which is not started.
+%
+%   POOL is [] when no pool is available. When TYPE is omitted it is
+%   taken from spotparams('parallel').
+%
+%   See also spotparams, spot.utils.applyChildren.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   if nargin < 1
+      type = spotparams('parallel');
+   end
+
+   pool = [];
+   try
+      switch lower(type)
+         case 'threads'
+            pool = backgroundPool;
+         case 'processes'
+            pool = gcp('nocreate');
+      end
+   catch
+      pool = [];
+   end
+end % function getPool
@@ -0,0 +1,73 @@
+function S = levelschedule(T,uplo)
+%levelschedule  Level schedule of a sparse triangular matrix.
+%
+%   S = levelschedule(T,UPLO) computes the level schedule of the sparse
+%   triangular matrix T, where UPLO is 'lower' or 'upper'. The unknowns
+%   of a triangular system are grouped in levels such that every unknown
+%   depends only on unknowns in earlier levels. All unknowns of a level
+%   can therefore be computed together, from a single sparse product with
+%   the rows of T in that level.
+%
+%   The schedule is used by spot.utils.levelsolve. When the levels hold
+%   too few unknowns on average to gain over a sequential substitution,
+%   the schedule only stores T and levelsolve uses backslash. The same
+%   holds when T is not triangular, as for the row-permuted L returned
+%   by ilu with the 'ilutp' type.
+%
+%   See also spot.utils.levelsolve, spotparams.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   minrows = 4;     % Minimum average number of unknowns per level
+
+   n = size(T,1);
+   S.T    = T;
+   S.perm = [];
+   S.rows = {};
+   S.blocks = {};
+   S.d    = [];
+
+   % Upper triangular systems are solved as lower triangular ones in
+   % reverse order.
+   if strcmpi(uplo,'upper')
+      S.perm = (n:-1:1)';
+      T = T(S.perm,S.perm);
+   end
+   T = sparse(T);
+   if ~istril(T)
+      S.useful = false;
+      return
+   end
+
+   % The level of each unknown is one more than the highest level of
+   % the unknowns it depends on. Columns are processed in order, so the
+   % level of column j is final when it is reached.
+   [i,j] = find(tril(T,-1));
+   ptr   = [0; cumsum(accumarray(j,1,[n 1]))];
+   level = ones(n,1);
+   for k=1:n
+      r = i(ptr(k)+1:ptr(k+1));
+      level(r) = max(level(r),level(k)+1);
+   end
+
+   nlevels = max([0; level]);
+   S.useful = n >= minrows*nlevels;
+   if ~S.useful
+      return
+   end
+
+   % Strictly lower rows and diagonal for each level
+   L      = tril(T,-1);
+   S.d    = full(diag(T));
+   [~,order] = sort(level);
+   counts = accumarray(level,1,[nlevels 1]);
+   S.rows   = mat2cell(order,counts,1);
+   S.blocks = cell(nlevels,1);
+   for k=1:nlevels
+      S.blocks{k} = L(S.rows{k},:);
+   end
+end % function levelschedule
@@ -0,0 +1,35 @@
+function X = levelsolve(S,B)
+%levelsolve  Solve a sparse triangular system by levels.
+%
+%   X = levelsolve(S,B) solves T*X = B, where S is the level schedule of
+%   the triangular matrix T computed by spot.utils.levelschedule. The
+%   unknowns of each level are computed for all columns of B at once.
+%
+%   See also spot.utils.levelschedule.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   if ~S.useful
+      X = S.T \ B;
+      return
+   end
+
+   B = full(B);
+   if ~isempty(S.perm)
+      B = B(S.perm,:);
+   end
+
+   X = zeros(size(B));
+   for k=1:length(S.rows)
+      I = S.rows{k};
+      X(I,:) = bsxfun(@rdivide, B(I,:) - S.blocks{k}*X, S.d(I));
+   end
+
+   if ~isempty(S.perm)
+      X(S.perm,:) = X;
+   end
+end % function levelsolve
@@ -0,0 +1,150 @@
+function M = materialize(A,varargin)
+%materialize  Convert a Spot operator to an explicit matrix.
+%
+%   M = materialize(A) returns the explicit matrix represented by the
+%   Spot operator A. The matrix is formed by applying A (or A' when A
+%   has fewer rows than columns) to blocks of unit vectors. Operators
+%   that support sweep products are therefore applied once per block
+%   instead of once per column.
+%
+%   materialize(A,'key',VAL,...) sets one or more of the following
+%   options:
+%
+%   'blocksize'  []     number of unit vectors per block. By default it
+%                       is chosen such that each block of the result
+%                       takes about 'blockmem' bytes.
+%   'blockmem'   2^26   target size in bytes of each block.
+%   'sparse'     []     true gives a sparse result, false a full one, and
+%                       'auto' gives a sparse result whenever at most 10%
+%                       of the entries are nonzero. When empty, the
+%                       result is sparse only if the products of A are.
+%   'memory'     Inf    maximum size of the result in bytes. An error is
+%                       raised when the result would exceed it.
+%   'workers'    0      number of workers over which the blocks are
+%                       divided (using PARFOR). Zero means serial.
+%
+%   See also opSpot.double, opSpot.full.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   import spot.utils.*
+
+   opts = parseOptions(varargin,{}, ...
+             {'blocksize','blockmem','sparse','memory','workers'});
+   blocksize = getOption(opts,'blocksize',[]);
+   blockmem  = getOption(opts,'blockmem',2^26);
+   sparsity  = getOption(opts,'sparse',[]);
+   memory    = getOption(opts,'memory',Inf);
+   workers   = getOption(opts,'workers',0);
+
+   % Work with the orientation that needs the fewest unit vectors.
+   [m,n] = size(A);
+   transposed = m < n;
+   if transposed
+      A = A';
+      [m,n] = deal(n,m);
+   end
+
+   % Bytes per entry of a full result.
+   if isreal(A), entry = 8; else entry = 16; end
+
+   if isempty(blocksize)
+      blocksize = floor(blockmem / (entry*max(m,1)));
+   end
+   blocksize = max(1,min(n,blocksize));
+   nblocks   = ceil(n / blocksize);
+
+   % Refuse to form a full result that exceeds the budget.
+   if isequal(sparsity,false) && entry*m*n > memory
+      error('SPOT:materialize:memory', ...
+            'Explicit %d-by-%d matrix exceeds the memory budget.',m,n);
+   end
+
+   if workers > 0
+      % Compute the blocks in parallel and gather them afterwards.
+      blocks = cell(1,nblocks);
+      parfor (k = 1:nblocks, workers)
+         blocks{k} = materializeBlock_intrnl(A,n,blocksize,k,sparsity);
+      end
+      M = gatherBlocks_intrnl(blocks,m,n,entry,sparsity,memory);
+   elseif isequal(sparsity,false)
+      % Serial, full: write each block directly into the result.
+      M = zeros(m,n);
+      for k=1:nblocks
+         idx = (k-1)*blocksize+1 : min(k*blocksize,n);
+         M(:,idx) = materializeBlock_intrnl(A,n,blocksize,k,false);
+      end
+   else
+      blocks = cell(1,nblocks);
+      nzbytes = 0;
+      for k=1:nblocks
+         blocks{k} = materializeBlock_intrnl(A,n,blocksize,k,sparsity);
+         if issparse(blocks{k})
+            nzbytes = nzbytes + 16*nnz(blocks{k});
+         else
+            nzbytes = nzbytes + entry*numel(blocks{k});
+         end
+         if nzbytes > memory
+            error('SPOT:materialize:memory', ...
+                  'Explicit %d-by-%d matrix exceeds the memory budget.',m,n);
+         end
+      end
+      M = gatherBlocks_intrnl(blocks,m,n,entry,sparsity,memory);
+   end
+
+   if transposed
+      M = M';
+   end
+end % function materialize
+
+
+%=======================================================================
+
+
+function Y = materializeBlock_intrnl(A,n,blocksize,k,sparsity)
+% Apply A to unit vectors (k-1)*blocksize+1 through k*blocksize.
+
+   idx = (k-1)*blocksize+1 : min(k*blocksize,n);
+   q   = length(idx);
+   E   = sparse(idx,1:q,1,n,q);
+   Y   = A*E;
+
+   if isequal(sparsity,true) || ischar(sparsity)
+      Y = sparse(Y);
+   elseif isequal(sparsity,false)
+      Y = full(Y);
+   end
+end
+
+
+%=======================================================================
+
+
+function M = gatherBlocks_intrnl(blocks,m,n,entry,sparsity,memory)
+% Concatenate the blocks and settle on the storage format.
+
+   if ischar(sparsity)
+      % 'auto' -- keep the result sparse only if it pays off.
+      nz = 0;
+      for k=1:length(blocks), nz = nz + nnz(blocks{k}); end
+      sparsity = nz <= 0.1*m*n;
+      if ~sparsity && entry*m*n > memory
+         error('SPOT:materialize:memory', ...
+               'Explicit %d-by-%d matrix exceeds the memory budget.',m,n);
+      end
+   end
+
+   M = [blocks{:}];
+   if isempty(blocks)
+      M = zeros(m,n);
+   end
+   if isequal(sparsity,true)
+      M = sparse(M);
+   elseif isequal(sparsity,false)
+      M = full(M);
+   end
+end
@@ -0,0 +1,76 @@
+function P = promote(A)
+%promote  Replace a frequently applied operator by an explicit matrix.
+%
+%   P = promote(A) decides whether the Spot operator A should be
+%   replaced by an explicit matrix and, if so, forms the matrix and
+%   stores it as an opMatrix with the operator. Subsequent products
+%   with A, or any copy of it, are then done with the matrix instead.
+%   P is the opMatrix, or empty when A is not (yet) promoted.
+%
+%   This function is called after each product with a composite
+%   operator when spotparams('promote') is true. The decision is based
+%   on the average time per product recorded in the counter of A:
+%
+%   - the product with the explicit matrix must be cheaper than the
+%     measured time per product, assuming 1 ns per stored entry;
+%   - the time already spent on products with A must exceed the
+%     estimated time needed to form the matrix, which takes about
+%     min(size(A)) products.
+%
+%   The second rule means that the matrix is formed only once A has
+%   been used about as many times as there are products in forming it,
+%   which bounds the time lost when A turns out not to be used again.
+%   Matrices are stored sparse when at most 10% of the entries are
+%   nonzero. Operators whose explicit matrix exceeds
+%   spotparams('promotemem') bytes, as well as nonlinear operators, are
+%   never promoted.
+%
+%   See also spotparams, spot.utils.materialize, spot.counter.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   minprods = 3;       % Minimum number of timed products
+   entrycost= 1e-9;    % Estimated time per entry of an explicit product
+
+   c = A.counter;
+   P = [];
+   if isfield(c.cache,'promoted')
+      % The decision has already been made.
+      P = c.cache.promoted;
+      return
+   end
+
+   if ~A.linear
+      c.cache.promoted = [];
+      return
+   end
+
+   timed = c.timed1 + c.timed2;
+   if timed < minprods, return, end
+   spent = c.time1 + c.time2;
+   tavg  = spent / timed;
+
+   [m,n] = size(A);
+   if entrycost*m*n >= tavg, return, end
+   if spent < min(m,n)*tavg, return, end
+
+   % Form the matrix without promoting any of the operators in A.
+   spotparams('promote',false);
+   try
+      M = spot.utils.materialize(A,'sparse','auto', ...
+                                 'memory',spotparams('promotemem'));
+      P = opMatrix(M);
+   catch err
+      if ~strcmp(err.identifier,'SPOT:materialize:memory')
+         spotparams('promote',true);
+         rethrow(err);
+      end
+   end
+   spotparams('promote',true);
+
+   c.cache.promoted = P;
+end % function promote
@@ -1,5 +1,11 @@
 classdef spottree
-%spottree
+%spottree  Tree representation of a Spot operator.
+%
+%   T = spot.utils.spottree(OP) builds the tree of operator OP and its
+%   children. plot(T) draws the tree using GraphViz, flops(T) counts
+%   the flops needed to aggregate it, and report(T) summarizes the
+%   products recorded in the counters of all nodes; see spotparams
+%   'profile'. plot(T,'profile') annotates the nodes with these costs.
 %
 %   Copyright 2009, Kai Chen and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -44,12 +50,20 @@ classdef spottree
       
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-      function plot(tree)
+      function plot(tree,annotate)
       %plot  Plot the tree using GraphViz.
+      %
+      %   plot(TREE,'profile') adds the inclusive and exclusive time
+      %   of the products with each node to the labels.
 
+         annotate = nargin > 1 && strcmpi(annotate,'profile');
          tmpFile = 'graphVizInput.txt';
          fid = fopen(tmpFile, 'w+');
-         [result,node] = buildGraphVizInput(tree);
+         prof = [];
+         if annotate
+            prof = profileNodes(tree,0);
+         end
+         [result,node] = buildGraphVizInput(tree,[],prof);
          graphVizInput = ['digraph G{\n', result, '}'];
          fprintf(fid, graphVizInput);
          fclose(fid);
@@ -101,6 +115,49 @@ classdef spottree
       end % function flops
 
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+      function s = report(tree)
+      %report  Profile of the products with each node of the tree.
+      %
+      %   report(TREE) prints, for every node, the number of products
+      %   and columns in each mode, the bytes of input and output, and
+      %   the inclusive and exclusive time of its products. The
+      %   inclusive time includes that of the children, the exclusive
+      %   time does not. Columns and bytes are only recorded while
+      %   spotparams('profile') is true. Times are recorded for all
+      %   products while profiling, but the same counter fields are also
+      %   filled by the scheduler of spotparams('parallel') and by
+      %   promotion (spotparams('promote')), so with profiling off they
+      %   may be nonzero and cover only some of the products.
+      %
+      %   S = report(TREE) returns this information as a struct array
+      %   with one entry per node, in depth-first order, instead.
+      %
+      %   Copies of an operator share their counter, so an operator
+      %   that appears more than once reports the total of all its
+      %   occurrences at each of them. Its time is subtracted only once
+      %   from the exclusive time of the parent.
+
+         s = profileNodes(tree,0);
+
+         if nargout == 0
+            total = max([s.inclusive, eps]);
+            fprintf('\n%-32s %15s %15s %11s %11s %10s %6s\n', ...
+                    'operator','products','columns','bytes in', ...
+                    'bytes out','excl (s)','excl%');
+            for i=1:length(s)
+               label = [repmat('  ',1,s(i).depth), s(i).label];
+               fprintf('%-32s %7d/%-7d %7d/%-7d %11d %11d %10.3e %5.1f%%\n', ...
+                       label, s(i).products, s(i).columns, ...
+                       s(i).bytesin, s(i).bytesout, s(i).exclusive, ...
+                       100*s(i).exclusive/total);
+            end
+            fprintf('\nTotal time %.3e s\n\n', s(1).inclusive);
+            clear s
+         end
+      end % function report
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
       
    end % methods - public
    
@@ -110,11 +167,18 @@ classdef spottree
 
    methods (Access = private)      
 
-      function [result,node] = buildGraphVizInput(tree,node)
+      function [result,node] = buildGraphVizInput(tree,node,prof)
       %buildGraphVizInput  Helper routine for plot method.
+      %
+      %   PROF is the profile of the whole tree from profileNodes, or []
+      %   for no annotation. Nodes are numbered in the same depth-first
+      %   order, so node k is described by PROF(k+1).
          if nargin < 2 || isempty(node)
             node = 0;
          end
+         if nargin < 3
+            prof = [];
+         end
          
          numChildren = numel(tree.children);
          
@@ -126,6 +190,11 @@ classdef spottree
          end
          [m,n]   = size(tree.node.op);
          opLabel = sprintf('%s %dx%d',opType,m,n);
+         if ~isempty(prof)
+            s = prof(node+1);
+            opLabel = sprintf('%s\\\\nincl %.2es\\\\nexcl %.2es', ...
+                              opLabel,s.inclusive,s.exclusive);
+         end
     
          result = [curNode, ' [label="', opLabel,'"];\n'];
 
@@ -137,7 +206,7 @@ classdef spottree
                childS = size(tree.children(i).node.op);
                childNode = ['node_', num2str(node)];
                result = [result , curNode, '->', childNode, ';\n'];
-               [res,node] = buildGraphVizInput(tree.children(i),node);
+               [res,node] = buildGraphVizInput(tree.children(i),node,prof);
                result = [result, res];
             end
          end
@@ -145,6 +214,44 @@ classdef spottree
       end % function buildGraphVizInput
 
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+      function s = profileNodes(tree,depth)
+      %profileNodes  Helper routine for report method.
+         op = tree.node.op;
+         s.depth     = depth;
+         s.label     = sprintf('%s %dx%d',op.type,size(op,1),size(op,2));
+         s.products  = [0 0];
+         s.columns   = [0 0];
+         s.bytesin   = 0;
+         s.bytesout  = 0;
+         s.inclusive = 0;
+         if isa(op,'opSpot') && ~isempty(op.counter)
+            c = op.counter;
+            s.products  = [c.mode1, c.mode2];
+            s.columns   = [c.cols1, c.cols2];
+            s.bytesin   = c.bytesin1  + c.bytesin2;
+            s.bytesout  = c.bytesout1 + c.bytesout2;
+            s.inclusive = c.time1 + c.time2;
+         end
+
+         % Exclusive time is what remains after the time of the children.
+         % Children sharing a counter are subtracted once.
+         s.exclusive = s.inclusive;
+         counters = {};
+         for i=1:numel(tree.children)
+            sc = profileNodes(tree.children(i),depth+1);
+            cop = tree.children(i).node.op;
+            if isa(cop,'opSpot') && ~isempty(cop.counter)
+               if ~any(cellfun(@(c) c == cop.counter, counters))
+                  counters{end+1} = cop.counter; %#ok<AGROW>
+                  s(1).exclusive = s(1).exclusive - sc(1).inclusive;
+               end
+            end
+            s = [s, sc]; %#ok<AGROW>
+         end
+      end % function profileNodes
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
       
    end % methods - private
       
@@ -0,0 +1,72 @@
+function writeMapped(filename,A,format,precision)
+%writeMapped  Write a matrix in the on-disk format of opMappedMatrix.
+%
+%   writeMapped(FILENAME,A,FORMAT,PRECISION) writes the real matrix A
+%   to FILENAME so that it can be used with opMappedMatrix. FORMAT is
+%   one of
+%
+%   'dense'  the entries of A in column-major order (default);
+%   'csc'    compressed sparse columns: the column pointers (N+1
+%            entries), row indices and values of the nonzeros;
+%   'csr'    compressed sparse rows: the row pointers (M+1 entries),
+%            column indices and values of the nonzeros.
+%
+%   Pointers and indices are zero-based and stored as int64. The values
+%   are stored with the given PRECISION, 'double' (default) or 'single'.
+%   All data is written in the native byte order.
+%
+%   See also opMappedMatrix.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   if nargin < 3 || isempty(format),    format    = 'dense';  end
+   if nargin < 4 || isempty(precision), precision = 'double'; end
+
+   if ~isreal(A)
+      error('SPOT:writeMapped:complex','Matrix must be real.');
+   end
+
+   fid = fopen(filename,'w');
+   if fid < 0, error('Cannot open %s for writing.',filename); end
+   cleanup = onCleanup(@() fclose(fid));
+
+   [m,n] = size(A);
+   switch lower(format)
+      case 'dense'
+         % Write a block of columns at a time to limit the memory used
+         % when A is sparse.
+         cols = max(1,floor(2^24 / max(m,1)));
+         for j=1:cols:n
+            fwrite(fid,full(A(:,j:min(n,j+cols-1))),precision);
+         end
+
+      case 'csc'
+         [i,j,v] = find(A);
+         writeCompressed_intrnl(fid,i,j,v,n,precision);
+
+      case 'csr'
+         [j,i,v] = find(A.');
+         writeCompressed_intrnl(fid,j,i,v,m,precision);
+
+      otherwise
+         error('Unknown format %s.',format);
+   end
+end % function writeMapped
+
+
+%=======================================================================
+
+
+function writeCompressed_intrnl(fid,ind,outer,val,nouter,precision)
+% Write the pointers, indices and values of a compressed sparse matrix.
+% The entries must be sorted by the outer index.
+
+   ptr = [0; cumsum(accumarray(outer(:),1,[nouter 1]))];
+   fwrite(fid,int64(ptr),'int64');
+   fwrite(fid,int64(ind(:)-1),'int64');
+   fwrite(fid,val(:),precision);
+end
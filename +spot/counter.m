@@ -10,6 +10,17 @@ classdef counter < handle
    properties
       mode1=0 % count of products A *x
       mode2=0 % count of products A'*y
+      time1=0 % seconds spent in timed products A *x
+      time2=0 % seconds spent in timed products A'*y
+      timed1=0 % count of timed products A *x
+      timed2=0 % count of timed products A'*y
+      cols1=0 % columns in profiled products A *x
+      cols2=0 % columns in profiled products A'*y
+      bytesin1=0 % bytes of the input of profiled products A *x
+      bytesin2=0 % bytes of the input of profiled products A'*y
+      bytesout1=0 % bytes of the output of profiled products A *x
+      bytesout2=0 % bytes of the output of profiled products A'*y
+      cache=struct() % quantities computed once for the operator
    end
    methods
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -22,5 +33,76 @@ classdef counter < handle
             error('Unrecognized mode.');
          end
       end % function plus1
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      function addtime(obj,mode,t)
+         if mode == 1
+            obj.time1  = obj.time1  + t;
+            obj.timed1 = obj.timed1 + 1;
+         elseif mode == 2
+            obj.time2  = obj.time2  + t;
+            obj.timed2 = obj.timed2 + 1;
+         else
+            error('Unrecognized mode.');
+         end
+      end % function addtime
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      function addio(obj,mode,x,y)
+      %addio  Record the columns and bytes of a profiled product y = A*x.
+         bin  = numbytes(x);
+         bout = numbytes(y);
+         if mode == 1
+            obj.cols1     = obj.cols1     + size(x,2);
+            obj.bytesin1  = obj.bytesin1  + bin;
+            obj.bytesout1 = obj.bytesout1 + bout;
+         else
+            obj.cols2     = obj.cols2     + size(x,2);
+            obj.bytesin2  = obj.bytesin2  + bin;
+            obj.bytesout2 = obj.bytesout2 + bout;
+         end
+      end % function addio
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      function reset(obj)
+      %reset  Clear all counts, times and sizes; keep the cache.
+         obj.mode1 = 0;    obj.mode2 = 0;
+         obj.time1 = 0;    obj.time2 = 0;
+         obj.timed1 = 0;   obj.timed2 = 0;
+         obj.cols1 = 0;    obj.cols2 = 0;
+         obj.bytesin1 = 0; obj.bytesin2 = 0;
+         obj.bytesout1 = 0; obj.bytesout2 = 0;
+      end % function reset
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      function t = cost(obj,mode)
+      %cost  Average time of a timed product, NaN if none was timed.
+         if mode == 1
+            t = obj.time1 / obj.timed1;
+         else
+            t = obj.time2 / obj.timed2;
+         end
+      end % function cost
    end % methods
-end % classdef
\ No newline at end of file
+end % classdef
+
+
+%=======================================================================
+
+
+function b = numbytes(x)
+% Number of bytes used by the numeric array x.
+   if issparse(x)
+      b = nnz(x)*(8 + 8*(1+~isreal(x))) + 8*(size(x,2)+1);
+   elseif isnumeric(x)
+      switch class(x)
+         case {'double','int64','uint64'}, e = 8;
+         case {'single','int32','uint32'}, e = 4;
+         case {'int16','uint16'},          e = 2;
+         otherwise,                        e = 1;
+      end
+      b = numel(x)*e*(1+~isreal(x));
+   else
+      b = 0;
+   end
+end
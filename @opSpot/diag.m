@@ -1,8 +1,37 @@
-function d = diag(A)
+function [d,err] = diag(A,varargin)
 %DIAG  Diagonal operator and diagonals of an operator.
 %
 %   diag(OP) is the main diagonal of the Spot operator OP.
 %
+%   diag(OP,'key',VAL,...) sets one or more of the following options:
+%
+%   'method'     'auto'  method used to obtain the diagonal:
+%                'exact'       apply OP to blocks of unit vectors;
+%                'probe'       apply OP to one probing vector per color
+%                              of a banded operator (see 'bandwidth');
+%                'stochastic'  Hutchinson-type estimate with Rademacher
+%                              vectors (see 'tol').
+%                With 'auto', the diagonal is taken directly from the
+%                operator when its structure allows it (opDiag, opWindow,
+%                opMatrix, opKron, opBlockDiag, and sums and transposes
+%                of these). Otherwise 'probe' is used when 'bandwidth' is
+%                given, 'stochastic' when 'tol' is given, and 'exact' in
+%                all other cases.
+%   'bandwidth'  []      [LOWER UPPER] number of nonzero diagonals below
+%                        and above the main diagonal. A scalar applies to
+%                        both. The diagonal is then found with
+%                        LOWER+UPPER+1 products.
+%   'periodic'   false   the band wraps around, as for circular
+%                        convolutions.
+%   'tol'        1e-2    requested standard error of the stochastic
+%                        estimate relative to its largest entry.
+%   'maxprods'   n       maximum number of products for the stochastic
+%                        estimate.
+%   'blocksize'  []      number of vectors applied to OP at once.
+%
+%   [D,ERR] = diag(OP,...) also returns the estimated standard error of
+%   each entry of D. It is zero for all but the stochastic method.
+%
 %   See also opDiag.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
@@ -11,11 +40,183 @@ function d = diag(A)
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
+   import spot.utils.*
+
+   opts = parseOptions(varargin,{}, ...
+             {'method','bandwidth','periodic','tol','maxprods','blocksize'});
+   method    = lower(getOption(opts,'method','auto'));
+   bandwidth = getOption(opts,'bandwidth',[]);
+   periodic  = getOption(opts,'periodic',false);
+   tol       = getOption(opts,'tol',[]);
+   maxprods  = getOption(opts,'maxprods',size(A,2));
+   blocksize = getOption(opts,'blocksize',[]);
+
    [m,n] = size(A);
-   k = min(m,n);
+   k   = min(m,n);
+   err = zeros(k,1);
+
+   if strcmp(method,'auto')
+      d = diagStructural_intrnl(A);
+      if ~isempty(d) || k == 0
+         d = full(d(:)); return
+      elseif ~isempty(bandwidth)
+         method = 'probe';
+      elseif ~isempty(tol)
+         method = 'stochastic';
+      else
+         method = 'exact';
+      end
+   end
+   if isempty(blocksize)
+      blocksize = max(1,floor(2^26 / (16*max(m,1))));
+   end
+
+   switch method
+      case 'exact'
+         d = diagExact_intrnl(A,m,n,k,blocksize);
+
+      case 'probe'
+         if isempty(bandwidth)
+            error('The probing method requires the bandwidth option.');
+         end
+         d = diagProbe_intrnl(A,n,k,bandwidth,periodic);
+
+      case 'stochastic'
+         if isempty(tol), tol = 1e-2; end
+         [d,err] = diagStochastic_intrnl(A,n,k,tol,maxprods,blocksize);
+
+      otherwise
+         error('Unrecognized method: %s.',method);
+   end
+end % function diag
+
+
+%=======================================================================
+
+
+function d = diagStructural_intrnl(A)
+% Diagonal of operators with known structure; [] if not available.
+
+   d = [];
+   switch class(A)
+      case 'opDiag'
+         d = A.diag;
+
+      case 'opWindow'
+         d = A.window(:);
+
+      case 'opMatrix'
+         [m,n] = size(A.matrix);
+         d = reshape(A.matrix((0:min(m,n)-1)*(m+1)+1),[],1);
+
+      case 'opKron'
+         % diag(kron(B,C)) = kron(diag(B),diag(C)) for square B and C.
+         d = 1;
+         for i=1:length(A.children)
+            child = A.children{i};
+            if size(child,1) ~= size(child,2), d = []; return, end
+            d = kron(d,diag(child));
+         end
+
+      case 'opBlockDiag'
+         % Only square blocks without overlap lie on the diagonal.
+         mb = 0; nb = 0;
+         for i=1:length(A.children)
+            child = A.children{i};
+            if size(child,1) ~= size(child,2), return, end
+            mb = mb + size(child,1);
+            nb = nb + size(child,2);
+         end
+         if A.repeated
+            d = kron(A.weights,diag(A.children{1}));
+         elseif mb == size(A,1) && nb == size(A,2)
+            d = cell(length(A.children),1);
+            for i=1:length(A.children)
+               d{i} = A.weights(i) * diag(A.children{i});
+            end
+            d = vertcat(d{:});
+         end
+
+      case {'opSum','opMinus'}
+         d1 = diagStructural_intrnl(A.children{1});
+         d2 = diagStructural_intrnl(A.children{2});
+         if isempty(d1) || isempty(d2), return, end
+         if isa(A,'opSum'), d = d1 + d2; else d = d1 - d2; end
+
+      case 'opTranspose'
+         d = diagStructural_intrnl(A.children{1});
+
+      case 'opCTranspose'
+         d = conj(diagStructural_intrnl(A.children{1}));
+   end
+end
+
+
+%=======================================================================
+
+
+function d = diagExact_intrnl(A,m,n,k,blocksize)
+% Apply A to blocks of unit vectors and keep the diagonal entries.
+
    d = zeros(k,1);
-   for i=1:k
-       v = zeros(n,1); v(i) = 1;
-       w = A*v;
-       d(i) = w(i);
+   for j=1:blocksize:k
+      idx = j:min(j+blocksize-1,k);
+      q   = length(idx);
+      Y   = A*sparse(idx,1:q,1,n,q);
+      d(idx) = Y(sub2ind([m,q],idx,1:q));
+   end
+end
+
+
+%=======================================================================
+
+
+function d = diagProbe_intrnl(A,n,k,bandwidth,periodic)
+% Probe a banded operator with one vector per color. Columns j with
+% equal mod(j-1,c) never overlap in a row within the band.
+
+   if isscalar(bandwidth), bandwidth = [bandwidth bandwidth]; end
+   c = min(n,sum(bandwidth)+1);
+   if periodic
+      % The number of colors must divide n for the coloring to be
+      % consistent across the wrap-around.
+      while mod(n,c) ~= 0, c = c + 1; end
+   end
+
+   colors = mod((0:n-1)',c) + 1;
+   V = sparse(1:n,colors,1,n,c);
+   Y = A*V;
+   d = full(Y(sub2ind(size(Y),(1:k)',colors(1:k))));
+end
+
+
+%=======================================================================
+
+
+function [d,err] = diagStochastic_intrnl(A,n,k,tol,maxprods,blocksize)
+% Hutchinson-type estimate: the mean of v.*(A*v) over Rademacher
+% vectors v, with the standard error estimated from the samples.
+
+   blocksize = max(2,min([blocksize,maxprods,32]));
+   s1 = zeros(k,1);   % Sum of samples
+   s2 = zeros(k,1);   % Sum of squared magnitudes of the samples
+   N  = 0;
+   d  = s1; err = inf(k,1);
+   while N < maxprods
+      q = min(blocksize,maxprods-N);
+      V = sign(randn(n,q)); V(V == 0) = 1;
+      Y = full(A*V);
+      S = V(1:k,:) .* Y(1:k,:);
+      s1 = s1 + sum(S,2);
+      s2 = s2 + sum(abs(S).^2,2);
+      N  = N + q;
+
+      d = s1 / N;
+      if N > 1
+         err = sqrt(max(0,s2/N - abs(d).^2) / (N-1));
+      else
+         err = inf(k,1);
+      end
+      if max(err) <= tol * max(abs(d)), break, end
    end
+end
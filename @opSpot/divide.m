@@ -2,13 +2,15 @@ function x = divide(op,b,mode)
 %\  Backslash or left matrix divide.
 %
 %   X = A\B is similar to Matlab's backslash operator, except that A
-%   is always a Spot operator, and b is always a numeric column
-%   vector. X is computed as the solution to the least-squares problem
+%   is always a Spot operator, and b is always numeric. When b has
+%   several columns they are solved together by block LSQR. X is
+%   computed as the solution to the least-squares problem
 %
 %   (*)  minimize  ||Ax - b||_2.
 %
 %   The least-squares problem (*) is solved using LSQR with default
-%   parameters specified by spotparams.
+%   parameters specified by spotparams. When spotparams('cgprecision')
+%   is 'mixed', the mixed-precision solver spot.solvers.mplsqr is used.
 %
 %   See also mldivide, opSpot.mrdivide, opFoG, opInverse, opPInverse, spotparams.
 
@@ -26,5 +28,10 @@ function x = divide(op,b,mode)
    [m,n] = size(A);
    opts = spotparams;
    maxits = opts.cgitsfact * min(m,min(n,20));
-   x = spot.solvers.lsqr(m,n,A,b, ...
+   if strcmp(opts.cgprecision,'mixed')
+      solver = @spot.solvers.mplsqr;
+   else
+      solver = @spot.solvers.lsqr;
+   end
+   x = solver(m,n,A,b, ...
          opts.cgdamp,opts.cgtol,opts.cgtol,opts.conlim,maxits,opts.cgshow);
@@ -2,6 +2,12 @@ function M = double(A)
 %double  Converts a Spot operator to matrix.
 %
 %   double(A) converts a Spot operator to an explicit matrix.
+%
+%   The matrix is formed blockwise by spot.utils.materialize, which
+%   also provides options for sparse output, memory limits, and
+%   parallel evaluation.
+%
+%   See also spot.utils.materialize.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -9,8 +15,4 @@ function M = double(A)
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
-if size(A,1) < size(A,2)
-   M = (A'*speye(size(A,1)))';
-else
-   M = A*speye(size(A,2));
-end
+M = spot.utils.materialize(A);
@@ -10,6 +10,12 @@ function varargout = lsqr(A,b,varargin)
 %   documentation are also allowed here.  The usage is identical to
 %   Matlab's default version, except that the first argument must be a
 %   Spot operator.
+%
+%   When B has more than one column, all columns are solved together
+%   with spot.solvers.blsqr, which applies A once per iteration to the
+%   block of unconverged columns. The optional arguments TOL and MAXIT
+%   are supported in this case, and FLAG, RELRES and ITER are row
+%   vectors with one entry per column.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -17,6 +23,15 @@ function varargout = lsqr(A,b,varargin)
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
+    if size(b,2) > 1
+       if nargout > 4
+          error('Too many output arguments for multiple right-hand sides.');
+       end
+       varargout = cell(1,max(1,nargout));
+       [varargout{:}] = lsqrBlock_intrnl(A,b,varargin{:});
+       return
+    end
+
     fun = @(x,mode) lsqr_intrnl(A,x,mode);
 
     if nargout == 0
@@ -39,3 +54,27 @@ function y = lsqr_intrnl(A,x,mode)
       y = A' * x;
    end
 end % function lsqr_intrnl
+
+% ======================================================================
+% Multiple right-hand sides
+% ======================================================================
+function [x,flag,relres,iter] = lsqrBlock_intrnl(A,b,tol,maxit,varargin)
+   [m,n] = size(A);
+   if nargin < 3 || isempty(tol),   tol   = 1e-6;            end
+   if nargin < 4 || isempty(maxit), maxit = min(n,20);       end
+   for i=1:length(varargin)
+      if ~isempty(varargin{i})
+         error('Preconditioners and initial guesses are not supported for multiple right-hand sides.');
+      end
+   end
+
+   [x,istop,iter,r1norm] = spot.solvers.blsqr(m,n,A,b,0,tol,tol, ...
+                              spotparams('conlim'),maxit,false);
+
+   % Translate the LSQR stopping reasons to the flags of Matlab's LSQR.
+   flag = zeros(1,size(b,2));
+   flag(istop == 7) = 1;
+   flag(istop == 3 | istop == 6) = 4;
+   bnorm  = sqrt(sum(abs(b).^2,1));
+   relres = r1norm ./ max(bnorm,realmin);
+end % function lsqrBlock_intrnl
@@ -15,7 +15,9 @@ function x = mldivide(A,B)
 %   If A is a scalar and B is a spot operator, then X = opFoG(1/A,B).
 %
 %   The least-squares problem (*) is solved using LSQR with default
-%   parameters specified by spotparams.
+%   parameters specified by spotparams. When B has several columns they
+%   are solved together by block LSQR, unless the operator has
+%   its own divide routine.
 %
 %   See also opSpot.mrdivide, opFoG, opPInverse, spotparams.
 
@@ -74,10 +76,18 @@ elseif isnumeric(B)
       error('Matrix dimensions must agree.');
    end
    
-   % Pre-allocate result matrix and apply mldivide to each column
-   x = zeros(size(A,2),size(B,2));
-   for j=1:size(B,2)
-      x(:,j) = A.divide(B(:,j),1);
+   % The generic least-squares solve handles all columns together
+   % (see spot.solvers.blsqr). Operators with their own divide routine
+   % are given one column at a time.
+   meth = findobj(metaclass(A).MethodList,'Name','divide');
+   if size(B,2) > 1 && strcmp(meth(1).DefiningClass.Name,'opSpot')
+      x = A.divide(B,1);
+   else
+      % Pre-allocate result matrix and apply mldivide to each column
+      x = zeros(size(A,2),size(B,2));
+      for j=1:size(B,2)
+         x(:,j) = A.divide(B(:,j),1);
+      end
    end
    
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
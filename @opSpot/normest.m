@@ -1,44 +1,80 @@
-function [e,cnt] = normest(S,tol)
+function [e,cnt] = normest(S,tol,k)
 %NORMEST Estimate the matrix 2-norm.
 %
 %   normest(S) is an estimate of the 2-norm of the matrix S.
 %
 %   normest(S,tol) uses relative error tol instead of 1e-6.
 %
+%   normest(S,tol,k) iterates with a block of k vectors instead of
+%   min(8,size(S,2)). Each pass applies S and S' to the whole block at
+%   once, so operators that support sweep products are applied once
+%   per pass rather than once per vector.
+%
 %   [nrm,cnt] = normest(..) also gives the number of iterations used.
 %
-%   This function is a minor adaptation of Matlab's built-in NORMEST.
+%   The estimate is obtained by randomized subspace iteration on S'*S
+%   and is stored with the operator; subsequent calls with the same or
+%   a looser tolerance return it without applying S. The estimate is
+%   shared between S and its (conjugate) transpose.
+%
+%   This function is an adaptation of Matlab's built-in NORMEST.
 %
 %   See also NORM, COND, RCOND, CONDEST.
 
-if nargin < 2, tol = 1.0e-6; end
+if nargin < 2 || isempty(tol), tol = 1.0e-6; end
 maxiter = 100;
 [m,n] = size(S);
 cnt = 0;
+e   = 0;
+if m == 0 || n == 0, return, end
+if nargin < 3 || isempty(k), k = min(8,n); end
+k = max(1,min(k,n));
+
+% The 2-norm is shared with the transpose; keep it with the base operator.
+B = S;
+while isa(B,'opCTranspose') || isa(B,'opTranspose')
+   B = B.children{1};
+end
+cache = [];
+if ~isempty(B.counter)
+   cache = B.counter.cache;
+end
+if isfield(cache,'normest') && cache.normest.tol <= tol
+   e = cache.normest.value;
+   return
+end
 
-% Compute an "estimate" of the ab-val column sums.
+% Start with an "estimate" of the ab-val column sums, completed by
+% random vectors.
 v = ones(m,1);
 v(randn(m,1) < 0) = -1;
-x = abs(S'*v);
+X = [abs(full(S'*v)), randn(n,k-1)];
+[X,~] = qr(X,0);
 
-e = norm(x);
-if e == 0, return, end
-x = x/e;
-e0 = 0;
-while abs(e-e0) > tol*e
-   e0 = e;
-   Sx = S*x;
-   if nnz(Sx) == 0
-      Sx = rand(size(Sx));
+e0 = -Inf;
+restarted = false;
+while true
+   Y = full(S*X);
+   e = norm(Y);
+   if e == 0 && ~restarted
+      % The block lies in the null space; restart once from a random
+      % block before concluding that the norm is zero.
+      [X,~] = qr(randn(n,k),0);
+      restarted = true;
+      continue
    end
-   x = S'*Sx;
-   normx = norm(x);
-   e = normx/norm(Sx);
-   x = x/normx;
+   if e == 0 || abs(e-e0) <= tol*e, break, end
+   e0 = e;
+   [X,~] = qr(full(S'*Y),0);
    cnt = cnt+1;
    if cnt > maxiter
       warning('SPOT:normest:notconverge', '%s%d%s%g', ...
               'NORMEST did not converge for ', maxiter, ' iterations with tolerance ', tol);
-      break;
+      return
    end
 end
+
+if ~isempty(B.counter)
+   c = B.counter;
+   c.cache.normest = struct('value',e,'tol',tol);
+end
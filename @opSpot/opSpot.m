@@ -75,6 +75,22 @@ classdef opSpot
         
         function y = applyMultiply(op,x,mode)
             op.counter.plus1(mode);
+
+            % Composite operators may be replaced by an explicit matrix
+            % once they have been applied often enough.
+            promote = ~isempty(op.children) && spotparams('promote');
+            if promote
+                cache = op.counter.cache;
+                if isfield(cache,'promoted') && ~isempty(cache.promoted)
+                    y = applyMultiply(cache.promoted, x, mode);
+                    return
+                end
+            end
+            profile = spotparams('profile');
+            if promote || profile
+                t = tic;
+            end
+
             if op.sweepflag
                 y = op.multiply(x, mode);
             else
@@ -96,6 +112,16 @@ classdef opSpot
                     y(:,i) = op.multiply(x(:,i), mode);
                 end
             end
+
+            if promote || profile
+                op.counter.addtime(mode, toc(t));
+            end
+            if profile
+                op.counter.addio(mode, x, y);
+            end
+            if promote
+                spot.utils.promote(op);
+            end
         end
         
         function y = applyDivide(op, x, mode)
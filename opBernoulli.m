@@ -8,8 +8,9 @@ classdef opBernoulli < opSpot
 %
 %   opBernoulli(M,N,MODE) is the same as above, except that the
 %   parameter MODE controls the type of ensemble that is generated.
-%   The default is MODE=0 unless the overall memory requred exceeds 50
-%   MBs.
+%   The default is MODE=0 unless the overall memory required exceeds 10
+%   MBs, in which case MODE=4 is used if the bit-packed matrix fits in
+%   10 MBs, and MODE=1 otherwise.
 %
 %   MODE = 0 (default): generates an explicit unnormalized matrix with
 %   random +1/-1 entries. The overall storage is O(M*N).
@@ -23,6 +24,13 @@ classdef opBernoulli < opSpot
 %
 %   MODE = 3: same as MODE=2, but the matrix is implicit (see MODE=1).
 %
+%   MODE = 4: generates an explicit unnormalized matrix that is stored
+%   bit-packed, one bit per entry. This requires 64 times less memory
+%   than MODE=0 and gives the same matrix. Products are formed by
+%   expanding blocks of columns on the fly.
+%
+%   MODE = 5: same as MODE=4, but scaled as in MODE=2.
+%
 %   Available operator properties:
 %   .mode  gives the mode used to create the operator.
 
@@ -44,6 +52,8 @@ classdef opBernoulli < opSpot
        mode           % mode used when operator was created
        seed           % RNG seed when operator was created
        scale          % used for normalization
+       packed         % bit-packed sign matrix (modes 4 and 5)
+       blocksize      % no. of columns expanded at a time (modes 4 and 5)
     end % properties
     
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -63,6 +73,8 @@ classdef opBernoulli < opSpot
              reqst = 8*m*n;      % MBytes requested.
              if reqst < 10*MByte % If it's less than 10 MB,
                 mode = 0;        % use explicit matrix.
+             elseif reqst/64 < 10*MByte
+                mode = 4;        % use bit-packed matrix.
              else
                 mode = 1;
              end
@@ -74,42 +86,47 @@ classdef opBernoulli < opSpot
           op.mode = mode;
           [m,n] = size(op);
           
+          % The generated data and the resulting RNG state depend only
+          % on the size, mode and seed, and can be reused from the
+          % on-disk cache.
           switch mode
-             case 0
-                A = 2.0 * (randn(m,n) < 0) - 1;
+             case {0,2}
                 fun = @multiplyExplicit;
-               
              case 1
-                A = [];
-                for i=1:m, randn(n,1); end; % Ensure random state is advanced
                 op.scale = 1;
                 fun = @multiplyImplicit;
-
-             case 2
-                A = (2.0 * (randn(m,n) < 0) - 1) / sqrt(m);
-                fun = @multiplyExplicit;
-              
              case 3
-                A = [];
                 op.scale = 1/sqrt(m);
-                for i=1:m, randn(n,1); end; % Ensure random state is advanced
                 fun = @multiplyImplicit;
-                
-            case 4
+             case 4
+                op.scale = 1;
+                fun = @multiplyPacked;
+             case 5
+                op.scale = 1/sqrt(m);
+                fun = @multiplyPacked;
+             otherwise
                 error('Invalid mode.')
           end
+          [A,packed,blocksize,state,hit] = spot.utils.diskcache('opBernoulli', ...
+                {m,n,mode,op.seed}, @() opBernoulliGenerate_intrnl(m,n,mode),4);
+          if hit, rng(state); end
+          op.packed    = packed;
+          op.blocksize = blocksize;
           op.matrix = A;
           op.funHandle = fun;
+          op.sweepflag = ~isempty(A) || ~isempty(op.packed);
        end % Constructor
 
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        % Double
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function x = double(op)
-          if isempty(op.matrix)
-             x = double@opSpot(op);
-          else
+          if ~isempty(op.matrix)
              x = op.matrix;
+          elseif ~isempty(op.packed)
+             x = op.scale * opBernoulliUnpack_intrnl(op.packed,op.m);
+          else
+             x = double@opSpot(op);
           end
        end % function double
 
@@ -166,7 +183,110 @@ classdef opBernoulli < opSpot
           % Restore original random number generator state
           rng(seed0);
        end % function multiplyImplicit
-       
+
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Multiply -  Bit-packed
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function y = multiplyPacked(op,x,mode)
+          m  = op.m;
+          n  = op.n;
+          q  = size(x,2);
+          nb = op.blocksize;
+
+          if mode == 1
+             y = zeros(m,q);
+             for k=1:nb:n
+                idx = k:min(k+nb-1,n);
+                B   = opBernoulliUnpack_intrnl(op.packed(:,idx),m);
+                y   = y + B * x(idx,:);
+             end
+          else
+             y = zeros(n,q);
+             for k=1:nb:n
+                idx = k:min(k+nb-1,n);
+                B   = opBernoulliUnpack_intrnl(op.packed(:,idx),m);
+                y(idx,:) = B' * x;
+             end
+          end
+
+          % Apply scaling
+          if op.scale ~= 1, y = y * op.scale; end
+       end % function multiplyPacked
+
     end % methods - private
     
 end % classdef
+
+
+%=======================================================================
+
+
+function [A,P,nb,state] = opBernoulliGenerate_intrnl(m,n,mode)
+% Generate the explicit or bit-packed matrix for the given mode, and
+% return the state of the RNG afterwards.
+
+A  = [];
+P  = [];
+nb = [];
+switch mode
+   case 0
+      A = 2.0 * (randn(m,n) < 0) - 1;
+
+   case 2
+      A = (2.0 * (randn(m,n) < 0) - 1) / sqrt(m);
+
+   case {1,3}
+      for i=1:m, randn(n,1); end; % Ensure random state is advanced
+
+   case {4,5}
+      [P,nb] = opBernoulliPack_intrnl(m,n);
+end
+state = rng;
+end
+
+
+%=======================================================================
+
+
+function [P,nb] = opBernoulliPack_intrnl(m,n)
+% Draw the signs column block by column block, which consumes the
+% random stream in the same order as randn(m,n), and pack each
+% column into ceil(m/8) bytes. Bit b of byte i in column j holds the
+% sign of entry 8*(i-1)+b+1, with a set bit meaning +1.
+
+w  = ceil(m/8);
+nb = max(1,floor(2^19 / max(1,8*w))); % Expand ~4 MB of doubles at a time
+P  = zeros(w,n,'uint8');
+p2 = 2.^(0:7)';
+
+for k=1:nb:n
+   idx  = k:min(k+nb-1,n);
+   bits = zeros(8*w,length(idx));
+   bits(1:m,:) = randn(m,length(idx)) < 0;
+   bits = reshape(bits,8,w*length(idx));
+   P(:,idx) = reshape(uint8(p2' * bits),w,length(idx));
+end
+end
+
+
+%=======================================================================
+
+
+function A = opBernoulliUnpack_intrnl(P,m)
+% Expand bit-packed columns into a dense +1/-1 matrix. Each byte is
+% mapped to its eight signs through a 256-by-8 lookup table, which
+% turns the unpacking into a single indexing operation.
+
+persistent table
+if isempty(table)
+   table = 2 * double(dec2bin(0:255,8) == '1') - 1;
+   table = table(:,end:-1:1); % Least significant bit first
+end
+
+[w,n] = size(P);
+A = table(double(P(:))+1,:).';
+A = reshape(A,8*w,n);
+if 8*w ~= m
+   A = A(1:m,:);
+end
+end
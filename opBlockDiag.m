@@ -19,6 +19,13 @@ classdef opBlockDiag < opSpot
 %   equal to ones(N,1). This will cause operator OP to be repeated
 %   N times.
 %
+%   When a single operator is repeated without overlap it is stored
+%   only once, and all blocks are applied to the input in a single
+%   (sweep) product with OP, followed by scaling with the weights.
+%   This applies only to the WEIGHT/N forms with a single operator;
+%   repeated operators listed explicitly, as in opBlockDiag(A,A,A),
+%   are not detected and are applied block by block.
+%
 %   See also opFoG, opKron, opDictionary.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
@@ -32,6 +39,8 @@ classdef opBlockDiag < opSpot
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     properties( SetAccess = private )
        funHandle     % Multiplication function
+       weights       % Block weights
+       repeated = false; % Single operator repeated along the diagonal
     end % properties
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -97,10 +106,15 @@ classdef opBlockDiag < opSpot
              cflag  = ~isreal(opA) || ~all(isreal(weights));
              linear = opA.linear;
 
-             % Add operators to list
-             for i=1:length(weights)
-                opListNew{end+1} = opA;
-             end             
+             % Add operators to list. Without overlap the blocks are
+             % applied jointly, and the operator is stored only once.
+             if overlap == 0
+                opListNew = {opA};
+             else
+                for i=1:length(weights)
+                   opListNew{end+1} = opA;
+                end
+             end
           else
              % Initialize
              m = 0; n = 0; cflag = 0; linear = 1;
@@ -123,7 +137,10 @@ classdef opBlockDiag < opSpot
 
         
           % Construct function handle
-          if overlap == 0
+          repeated = length(opList) == 1 && overlap == 0;
+          if repeated
+             fun = @(x,mode) opBlockDiagRepeat_intrnl(m,n,opList{1},weights,x,mode);
+          elseif overlap == 0
              fun = @(x,mode) opBlockDiag_intrnl(m,n,opList,weights,x,mode);
           elseif overlap < 0
              % Overlap in columns
@@ -161,6 +178,9 @@ classdef opBlockDiag < opSpot
           op.linear     = linear;
           op.children   = opList;
           op.funHandle  = fun;
+          op.weights    = weights;
+          op.repeated   = repeated;
+          op.sweepflag  = repeated;
       end
       
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -169,6 +189,12 @@ classdef opBlockDiag < opSpot
        function str = char(op)
           % Initialize
           str = 'BlockDiag(';
+
+          if op.repeated && length(op.weights) > 1
+             str = sprintf('%s%s x %d)',str,char(op.children{1}), ...
+                           length(op.weights));
+             return
+          end
        
           for i=1:length(op.children)
              strOp = char(op.children{i});
@@ -201,10 +227,54 @@ end % Classdef
 %=======================================================================
 
 
+function y = opBlockDiagRepeat_intrnl(m,n,op,weights,x,mode)
+
+% Stack the blocks of all columns of x side by side, and apply the
+% operator to all of them at once.
+K = length(weights);
+q = size(x,2);
+w = repmat(reshape(weights,1,K),1,q); % Weight of each stacked block
+
+if mode == 1
+   y = op * reshape(x,op.n,K*q);
+   if any(w ~= 1), y = bsxfun(@times,y,w); end
+   y = reshape(y,m,q);
+else
+   y = op' * reshape(x,op.m,K*q);
+   if any(w ~= 1), y = bsxfun(@times,y,conj(w)); end
+   y = reshape(y,n,q);
+end
+end
+
+
+%=======================================================================
+
+
 function y = opBlockDiag_intrnl(m,n,opList,weights,x,mode)
 
 kx = 0; ky = 0;
 
+if ~strcmp(spotparams('parallel'),'off')
+   % Evaluate the blocks concurrently
+   nops = length(opList);
+   xs   = cell(1,nops);
+   for i=1:nops
+      if mode == 1, s = opList{i}.n; else s = opList{i}.m; end
+      xs{i} = x(kx+1:kx+s);
+      kx    = kx + s;
+   end
+   ys = spot.utils.applyChildren(opList,xs,mode);
+   for i=1:nops
+      if mode == 1, w = weights(i); else w = conj(weights(i)); end
+      ys{i} = w * ys{i};
+   end
+   y = vertcat(ys{:});
+   if isempty(y)
+      if mode == 1, y = zeros(m,1); else y = zeros(n,1); end
+   end
+   return
+end
+
 if mode == 1
    y  = zeros(m,1);
    for i=1:length(opList)
@@ -85,6 +85,11 @@ classdef opBlockOp < opSpot
           bsr2 = op.blocksize2(1); % Block size in rows
           bsc2 = op.blocksize2(2); % Block size in columns
           
+          if ~strcmp(spotparams('parallel'),'off')
+             z = multiplyParallel(op,x,mode);
+             return
+          end
+
           if mode == 1
              y = full(reshape(x,m,n));
              z = zeros(nbr*bsr2,nbc*bsc2);
@@ -109,6 +114,37 @@ classdef opBlockOp < opSpot
           z = z(:);
        end % function multiply
 
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Multiply with the block rows evaluated concurrently
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function z = multiplyParallel(op,x,mode)
+          % The blocks of each block row are gathered as the columns
+          % of one matrix, which forms a single task.
+          nbr = op.nblocks(1);
+          nbc = op.nblocks(2);
+          if mode == 1
+             bin = op.blocksize1; bout = op.blocksize2;
+          else
+             bin = op.blocksize2; bout = op.blocksize1;
+          end
+          y = full(reshape(x,nbr*bin(1),nbc*bin(2)));
+
+          xs = cell(1,nbr);
+          for i=1:nbr
+             blk   = y((i-1)*bin(1)+(1:bin(1)),:);
+             blk   = reshape(blk,bin(1),bin(2),nbc);
+             xs{i} = reshape(blk,bin(1)*bin(2),nbc);
+          end
+          ops = repmat(op.children(1),1,nbr);
+          ys  = spot.utils.applyChildren(ops,xs,mode);
+
+          z = zeros(nbr*bout(1),nbc*bout(2));
+          for i=1:nbr
+             z((i-1)*bout(1)+(1:bout(1)),:) = reshape(ys{i},bout(1),bout(2)*nbc);
+          end
+          z = z(:);
+       end % function multiplyParallel
+
     end % methods - protected
         
 end % Classdef
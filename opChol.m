@@ -58,27 +58,21 @@ classdef opChol < opFactorization
       op.cflag       = ~isreal(A);
     end % function opChol
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % transpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = transpose(op)
-       opOut = inv(op.L.') * inv(op.L);
-    end
+  end % methods - public
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % conj
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = conj(op)
-       opOut = inv(conj(op.L')) * inv(conj(op.L));
-    end
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  % Methods - Protected
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  methods( Access = protected )
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % ctranpose
+    % solve
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = ctranspose(op)
-       opOut = inv(op.L') * inv(op.L);
-    end
+    function y = solve(op, x, mode)
+       % L*L' = A, which is Hermitian.
+       y = op.L' \ (op.L \ x);
+    end % function solve
 
-  end % methods - public
+  end % methods - protected
 
 end % classdef
@@ -13,7 +13,13 @@ classdef opCurvelet < opSpot
 %   determines the type of transformation and is set to 'WRAP' by
 %   default.
 %
-%   See also CURVELAB.
+%   For the 'WRAP' transform the offset of each wedge in the coefficient
+%   vector is computed once by the constructor, and the coefficients are
+%   converted to and from their real-valued form while being copied to
+%   or from the vector. This avoids the separate passes over the
+%   coefficients made by the Curvelab conversion routines.
+%
+%   See also CURVELAB, spot.utils.fdct_layout, spot.utils.fdct_pack.
 
 %   Copyright 2009, Gilles Hennenfent, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -45,32 +51,23 @@ classdef opCurvelet < opSpot
           finest  = 1;
           is_real = 1;
 
-          % Compute length of curvelet coefficient vector
-          if strcmp(ttype,'ME')
-             C = mefcv2(randn(m,n),m,n,nbscales,nbangles);
-
-             hdr{1}{1} = size(C{1}{1});
-             cn = prod(hdr{1}{1});
-             for i = 2:nbscales
-                nw = length(C{i});
-                hdr{i}{1} = size(C{i}{1});
-                hdr{i}{2} = size(C{i}{nw/2+1});
-                cn = cn + nw/2*prod(hdr{i}{1}) + nw/2*prod(hdr{i}{2});
-             end
+          % Compute length and layout of the curvelet coefficient
+          % vector. These depend only on the arguments, and can be
+          % reused from the on-disk cache.
+          % The key includes the date and size of the MEX file, so
+          % that a rebuilt transform invalidates the stored layout.
+          mex = which('fdct_wrapping_mex');
+          info = dir(mex);
+          if isempty(mex) || isempty(info)
+             mexkey = {mex};
           else
-             C = fdct_wrapping_mex(m,n,nbscales,nbangles,finest,randn(m,n));
-  
-             hdr{1}{1} = size(C{1}{1});
-             cn = prod(hdr{1}{1});  
-             for i = 2:nbscales
-                nw = length(C{i});
-                hdr{i}{1} = size(C{i}{1});
-                hdr{i}{2} = size(C{i}{nw/4+1});
-                cn = cn + nw/2*prod(hdr{i}{1}) + nw/2*prod(hdr{i}{2});
-             end
+             mexkey = {mex,info(1).datenum,info(1).bytes};
           end
+          [cn,hdr,L,fused] = spot.utils.diskcache('opCurvelet', ...
+             {m,n,nbscales,nbangles,ttype,finest,mexkey}, ...
+             @() opCurveletSetup_intrnl(m,n,nbscales,nbangles,ttype,finest));
 
-          parms = {m,n,cn,hdr,finest,nbscales,nbangles,is_real,ttype};
+          parms = {m,n,cn,hdr,L,fused,finest,nbscales,nbangles,is_real,ttype};
           fun   = @(x,mode) opCurvelet_intrnl(parms{:},x,mode);
 
           % Construct operator
@@ -98,25 +95,32 @@ end % Classdef
 %=======================================================================
 
 
-function y = opCurvelet_intrnl(m,n,cn,hdr,ac,nbs,nba,is_real,ttype,x,mode)
+function y = opCurvelet_intrnl(m,n,cn,hdr,L,fused,ac,nbs,nba,is_real,ttype,x,mode)
 
 if mode == 1
    % Analysis mode
    if strcmp(ttype,'ME')
       y = mefcv2(reshape(x,m,n),m,n,nbs,nba);
+      y = spot.utils.fdct_c2v(y,cn);
    else
       y = fdct_wrapping_mex(m,n,nbs,nba,ac,reshape(x,m,n));
-      y = fdct_wrapping_c2r(y);
+      if fused
+         y = spot.utils.fdct_pack(y,L);
+      else
+         y = spot.utils.fdct_c2v(fdct_wrapping_c2r(y),L);
+      end
    end
-   y = spot.utils.fdct_c2v(y,cn);
 else
    % Synthesis mode  
    if strcmp(ttype,'ME')
       x = mefdct_v2c(x,hdr,nba);
       y = meicv2(x,m,n,nbs,nba);
    else
-      x = spot.utils.fdct_v2c(x,hdr,ac,nba);
-      x = fdct_wrapping_r2c(x);
+      if fused
+         x = spot.utils.fdct_unpack(x,L);
+      else
+         x = fdct_wrapping_r2c(spot.utils.fdct_v2c(x,L));
+      end
       y = ifdct_wrapping_mex(m,n,nbs,nba,ac,x);
    end
    if is_real
@@ -125,3 +129,79 @@ else
    y = y(:);
 end
 end
+
+
+%=======================================================================
+
+
+function [cn,hdr,L,fused] = opCurveletSetup_intrnl(m,n,nbscales,nbangles,ttype,finest)
+% Apply the transform to a sample input to determine the size of each
+% wedge. The sample is drawn from a private stream, so that the result
+% does not depend on, or advance, the global RNG.
+
+rs = RandStream('mt19937ar','Seed',0);
+if strcmp(ttype,'ME')
+   C = mefcv2(randn(rs,m,n),m,n,nbscales,nbangles);
+
+   hdr{1}{1} = size(C{1}{1});
+   cn = prod(hdr{1}{1});
+   for i = 2:nbscales
+      nw = length(C{i});
+      hdr{i}{1} = size(C{i}{1});
+      hdr{i}{2} = size(C{i}{nw/2+1});
+      cn = cn + nw/2*prod(hdr{i}{1}) + nw/2*prod(hdr{i}{2});
+   end
+else
+   C = fdct_wrapping_mex(m,n,nbscales,nbangles,finest,randn(rs,m,n));
+
+   hdr{1}{1} = size(C{1}{1});
+   cn = prod(hdr{1}{1});  
+   for i = 2:nbscales
+      nw = length(C{i});
+      hdr{i}{1} = size(C{i}{1});
+      hdr{i}{2} = size(C{i}{nw/4+1});
+      cn = cn + nw/2*prod(hdr{i}{1}) + nw/2*prod(hdr{i}{2});
+   end
+end
+
+% Layout of the coefficient vector and check whether the fused
+% real-valued packing matches the Curvelab conversion routines.
+L     = [];
+fused = false;
+if ~strcmp(ttype,'ME')
+   L     = spot.utils.fdct_layout(C);
+   fused = opCurveletCheck_intrnl(C,L,rs);
+end
+end
+
+
+%=======================================================================
+
+
+function ok = opCurveletCheck_intrnl(C,L,rs)
+% Check that the fused packing agrees with fdct_wrapping_c2r and
+% fdct_wrapping_r2c for the sample coefficients C.
+
+tol = 1e-10;
+ok  = false;
+try
+   y0 = spot.utils.fdct_c2v(fdct_wrapping_c2r(C),L);
+   y1 = spot.utils.fdct_pack(C,L);
+   if ~isreal(y0) || norm(y1 - y0) > tol*norm(y0), return, end
+
+   x  = randn(rs,L.offset(end),1);
+   C0 = fdct_wrapping_r2c(spot.utils.fdct_v2c(x,L));
+   C1 = spot.utils.fdct_unpack(x,L);
+   for k = 1:L.count
+      A0 = C0{L.scale(k)}{L.wedge(k)};
+      A1 = C1{L.scale(k)}{L.wedge(k)};
+      if ~isequal(size(A0),size(A1)) || ...
+         norm(A1(:) - A0(:)) > tol*max(1,norm(A0(:)))
+         return
+      end
+   end
+   ok = true;
+catch
+   ok = false;
+end
+end
@@ -2,7 +2,8 @@ classdef opDCT < opOrthogonal
 %OPDCT  Discrete cosine transform (DCT).
 %
 %   opDCT(M) creates a one-dimensional discrete cosine transform
-%   operator for vectors of length M.
+%   operator for vectors of length M. The transform weights are
+%   computed once per size (see spot.utils.dctplan).
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -10,6 +11,13 @@ classdef opDCT < opOrthogonal
 
 %   http://www.cs.ubc.ca/labs/scl/spot
 
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   % Properties
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   properties( SetAccess = private )
+      plan;         % Precomputed DCT weights
+   end % properties - private
+
    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
    % Methods - public
    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -27,6 +35,7 @@ classdef opDCT < opOrthogonal
          end
          op = op@opOrthogonal('DCT',m,m);
          op.sweepflag   = true;
+         op.plan        = spot.utils.dctplan(m);
       end % function opDCT
       
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -60,11 +69,7 @@ classdef opDCT < opOrthogonal
       % multiply.
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
       function y = multiply(op,x,mode)
-         if mode == 1
-            y = spot.utils.dct(full(x));
-         else
-            y = spot.utils.idct(full(x));
-         end
+         y = spot.utils.dctexec(op.plan,x,mode);
       end % function multiply
       
    end % methods - protected
@@ -17,6 +17,7 @@ classdef opDCT2 < opOrthogonal
    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
    properties( SetAccess = private )
       inputdims;    % Dimensions of the input
+      plans;        % Precomputed DCT weights for each dimension
    end % properties - private
    
    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -41,6 +42,8 @@ classdef opDCT2 < opOrthogonal
          end
          op = op@opOrthogonal('DCT2',m*n,m*n);
          op.inputdims = [m,n];
+         op.sweepflag = true;
+         op.plans     = {spot.utils.dctplan(m), spot.utils.dctplan(n)};
       end % function opDCT2
       
       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -82,15 +85,14 @@ classdef opDCT2 < opOrthogonal
       function y = multiply(op,x,mode)
          m = op.inputdims(1);
          n = op.inputdims(2);
-         if mode == 1
-            y = spot.utils.dct(full(reshape(x,m,n)));
-            y = spot.utils.dct(y')';
-            y = y(:);
-         else
-            y = spot.utils.idct(full(reshape(x,m,n)));
-            y = spot.utils.idct(y')';
-            y = y(:);
-         end
+         q = size(x,2);
+
+         % Transform the columns of all q images at once, then the rows.
+         y = spot.utils.dctexec(op.plans{1},reshape(x,m,n*q),mode);
+         y = permute(reshape(y,m,n,q),[2,1,3]);
+         y = spot.utils.dctexec(op.plans{2},reshape(y,n,m*q),mode);
+         y = permute(reshape(y,n,m,q),[2,1,3]);
+         y = reshape(y,m*n,q);
       end % function multiply
       
    end % methods - protected
@@ -115,6 +115,10 @@ classdef opDictionary < opSpot
        % Multiply
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function y = multiply(op,x,mode)
+          if ~strcmp(spotparams('parallel'),'off')
+             y = multiplyParallel(op,x,mode);
+             return
+          end
           if mode == 1
              y = zeros(op.m,1);
              k = 0;
@@ -136,6 +140,30 @@ classdef opDictionary < opSpot
           end
        end % Multiply          
 
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Multiply with the children evaluated concurrently
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function y = multiplyParallel(op,x,mode)
+          if mode == 1
+             nops = length(op.children);
+             xs   = cell(1,nops);
+             k    = 0;
+             for i=1:nops
+                s     = size(op.children{i},2);
+                xs{i} = x(k+1:k+s);
+                k     = k + s;
+             end
+             ys = spot.utils.applyChildren(op.children,xs,1);
+             y  = zeros(op.m,1);
+             for i=1:nops
+                y = y + ys{i};
+             end
+          else
+             y = spot.utils.applyChildren(op.children,x,2);
+             y = vertcat(y{:});
+          end
+       end % MultiplyParallel
+
     end % Methods
    
 end % Classdef
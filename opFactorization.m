@@ -2,6 +2,18 @@ classdef opFactorization < opSpot
 %OPFACTORIZATION  Operator representing an inverse by way of a factorization.
 %                 Useful to avoid multiple factorizations as in opInverse
 %                 and save time by performing only forward and backsolves.
+%
+%   Subclasses implement SOLVE, which applies the permutations and the
+%   triangular solves of the factorization to a whole block of
+%   right-hand sides at once. Products with the operator call SOLVE and
+%   perform iterative refinement on all columns of the block together.
+%   Products with the adjoint B' and transpose B.' call SOLVE in mode 2.
+%
+%   When spotparams('levelsolve') is true, the triangular solves with
+%   the incomplete factors of opiLU and opiChol are done level by level
+%   (see spot.utils.levelschedule): all unknowns of a level are computed
+%   together, which takes one sparse product per level instead of one
+%   sequential substitution.
 
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Properties
@@ -61,30 +73,77 @@ classdef opFactorization < opSpot
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % multiply
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function y = multiply(op, x, ~)
-       y = op.Ainv * x;
+    function y = multiply(op, x, mode)
+       y = op.solve(x, mode);
        % Perform iterative refinement if necessary / requested
        if op.nitref > 0
-          r = x - op.A * y;
-          rNorm = norm(r, 'inf'); %#ok<*PROP>
-          xNorm = norm(x, 'inf');
+          if mode == 1
+             A = op.A;
+          else
+             A = op.A';
+          end
+          r = x - A * y;
+          rNorm = max(abs(r), [], 1); %#ok<*PROP>
+          xNorm = max(abs(x), [], 1);
           nit = 0;
-          while nit < op.nitref && (rNorm >= op.itref_tol * xNorm || op.force_itref)
-             dy = op.Ainv * r;
+          while nit < op.nitref && (any(rNorm >= op.itref_tol * xNorm) || op.force_itref)
+             dy = op.solve(r, mode);
              y = y + dy;
-             r = x - op.A * y;
-             rNorm = norm(r, 'inf');
+             r = x - A * y;
+             rNorm = max(abs(r), [], 1);
              nit = nit + 1;
           end
-          op.rNorm = rNorm;
+          op.rNorm = max([0 rNorm]);
        end
     end % function multiply
 
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % solve
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    function y = solve(op, x, mode)
+       % Apply the inverse (mode 1) or its adjoint (mode 2) to the
+       % block x. Subclasses solve with the factors directly.
+       if mode == 1
+          y = op.Ainv * x;
+       else
+          y = op.Ainv' * x;
+       end
+    end % function solve
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % trisolve
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    function y = trisolve(op, T, x, uplo, key)
+       % Solve with the triangular factor T. With level scheduling the
+       % schedule of T is computed once and kept in the counter, which
+       % is shared by all copies of the operator, under the given key.
+       if ~spotparams('levelsolve')
+          y = T \ x;
+          return
+       end
+       c = op.counter;
+       if ~isfield(c.cache, 'levels') || ~isfield(c.cache.levels, key)
+          S = spot.utils.levelschedule(T, uplo);
+          if isfield(c.cache, 'levels')
+             levels = c.cache.levels;
+          else
+             levels = struct();
+          end
+          levels.(key) = S;
+          c.cache.levels = levels;
+       end
+       y = spot.utils.levelsolve(c.cache.levels.(key), x);
+    end % function trisolve
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % divide
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function x = divide(op, b, ~)
-       x = op.A * b;
+    function x = divide(op, b, mode)
+       if mode == 1
+          x = op.A * b;
+       else
+          x = op.A' * b;
+       end
     end % function divide
 
   end % methods - protected
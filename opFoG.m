@@ -8,7 +8,12 @@ classdef opFoG < opSpot
 %   The inputs must be either Spot operators or explicit Matlab matrices
 %   (including scalars).
 %
-%   See also opDictionary, opStack, opSum.
+%   The product of opRestriction or opMask with opDFT or opDFT2 is
+%   applied with opPartialDFT, which computes only the selected
+%   frequencies. The children are not applied, and their counters are
+%   not updated, in that case.
+%
+%   See also opDictionary, opStack, opSum, opPartialDFT.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -23,6 +28,10 @@ classdef opFoG < opSpot
         operators = {}; % List of preprocessed operators
     end % Properties
 
+    properties (Access = private)
+        fused = [];     % Fused partial Fourier transform, if any
+    end % Properties
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % Methods
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -74,6 +83,9 @@ classdef opFoG < opSpot
           % Preprocess children
           if isscalar(A), op.children{1} = opMatrix(double(A)); end
           if isscalar(B), op.children{2} = opMatrix(double(B)); end
+
+          op.fused = fuseFourier_intrnl(op.children{1},op.children{2});
+          if ~isempty(op.fused), op.sweepflag = true; end
        end % Constructor
        
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -116,7 +128,9 @@ classdef opFoG < opSpot
        % Multiply
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function z = multiply(op,x,mode)
-           if mode == 1
+           if ~isempty(op.fused)
+              z = multiplyFused_intrnl(op.fused,x,mode);
+           elseif mode == 1
               y = applyMultiply(op.children{2},x,mode);
               z = applyMultiply(op.children{1},y,mode);
            else
@@ -128,3 +142,59 @@ classdef opFoG < opSpot
     end % Methods
    
 end % Classdef
+
+
+%=======================================================================
+
+
+function f = fuseFourier_intrnl(A,B)
+% Return the partial Fourier transform equivalent to A*B when A selects
+% entries of the output of a DFT B, and [] otherwise.
+
+   f = [];
+   if isa(B,'opDFT')
+      dims = B.n;
+   elseif isa(B,'opDFT2')
+      dims = B.inputdims;
+   else
+      return
+   end
+
+   if isa(A,'opRestriction')
+      idx  = A.index;
+      rows = [];
+   elseif isa(A,'opMask')
+      idx  = find(A.mask);
+      rows = idx;
+   else
+      return
+   end
+   if A.n ~= B.m, return, end
+
+   f.op   = opPartialDFT(dims,idx,B.centered);
+   f.rows = rows;
+   f.m    = A.m;
+end
+
+
+%=======================================================================
+
+
+function z = multiplyFused_intrnl(f,x,mode)
+% Apply the fused transform. For masks the selected entries are
+% embedded in a zero vector of the full length.
+
+   if mode == 1
+      z = f.op * x;
+      if ~isempty(f.rows)
+         y = z;
+         z = zeros(f.m,size(x,2));
+         z(f.rows,:) = y;
+      end
+   else
+      if ~isempty(f.rows)
+         x = x(f.rows,:);
+      end
+      z = f.op' * x;
+   end
+end
@@ -76,51 +76,27 @@ classdef opGaussian < opSpot
           op.mode = mode;
           [m,n] = size(op);
           
-          % Construct the internal representation
+          % Construct the internal representation. The generated data
+          % and the resulting RNG state depend only on the size, mode
+          % and seed, and can be reused from the on-disk cache.
+          if any(mode == [4 5]) && m > n
+             error('This mode is not supported when M > N.');
+          end
           switch mode
-             case 0
-                A = randn(m,n);
+             case {0,2,4}
                 fun = @multiplyExplicit;
-
-             case 1
-                A = [];
-                for i=1:m, randn(n,1); end; % Ensure random state is advanced
+             case {1,5}
                 fun = @multiplyImplicit;
-
-             case 2
-                A  = randn(m,n);
-                A  = A * spdiags((1./sqrt(sum(A.*A)))',0,n,n);
-                fun = @multiplyExplicit;
-
-              case 3
-                A = [];
-                op.scale = zeros(1,n);
-                for i=1:n
-                   v = randn(m,1);
-                   op.scale(i) = 1 / sqrt(v'*v);
-                end
+             case 3
                 fun = @multiplyImplicitScaled;
-
-             case 4
-                if m > n
-                   error('This mode is not supported when M > N.');
-                end;
-                A = randn(n,m);   % NB: dimensions are reversed
-                [Q,R] = qr(A,0);
-                A = Q';           % Now A has the correct shape
-                fun = @multiplyExplicit;
-
-             case 5 % Not documented.
-               if m > n
-                  error('This mode is not supported when M > N.');
-               end;
-               A  = randn(m,n);
-               A  = orth(A')';
-               fun = @multiplyImplicit;
-
              otherwise
                error('Invalid mode.')
           end
+          [A,scale,state,hit] = spot.utils.diskcache('opGaussian', ...
+                               {m,n,mode,op.seed}, ...
+                               @() opGaussianGenerate_intrnl(m,n,mode),3);
+          if hit, rng(state); end
+          op.scale = scale;
           op.matrix = A;
           op.funHandle = fun;
        end % Constructor
@@ -216,3 +192,43 @@ classdef opGaussian < opSpot
     end % methods - private
     
 end % Classdef
+
+
+%=======================================================================
+
+
+function [A,scale,state] = opGaussianGenerate_intrnl(m,n,mode)
+% Generate the matrix or column scaling for the given mode, and return
+% the state of the RNG afterwards.
+
+   A     = [];
+   scale = [];
+   switch mode
+      case 0
+         A = randn(m,n);
+
+      case 1
+         for i=1:m, randn(n,1); end; % Ensure random state is advanced
+
+      case 2
+         A = randn(m,n);
+         A = A * spdiags((1./sqrt(sum(A.*A)))',0,n,n);
+
+      case 3
+         scale = zeros(1,n);
+         for i=1:n
+            v = randn(m,1);
+            scale(i) = 1 / sqrt(v'*v);
+         end
+
+      case 4
+         A = randn(n,m);   % NB: dimensions are reversed
+         [Q,R] = qr(A,0);
+         A = Q';           % Now A has the correct shape
+
+      case 5
+         A = randn(m,n);
+         A = orth(A')';
+   end
+   state = rng;
+end
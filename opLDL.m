@@ -34,6 +34,10 @@ classdef opLDL < opFactorization
     D             % Diagonal factor
   end
 
+  properties( Access = private )
+    p             % Permutation vector
+  end
+
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Methods - Public
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -62,7 +66,8 @@ classdef opLDL < opFactorization
       op.A            = opHermitian(B);
       [op.L, op.D, p] = ldl(tril(B), 'vector');
       op.P            = opPermutation(p);
-      op.Ainv         = op.P * inv(op.L') * inv(op.D) * inv(op.L) * op.P';
+      op.p            = p;
+      op.Ainv         = op.P' * inv(op.L') * inv(op.D) * inv(op.L) * op.P;
       op.cflag        = ~isreal(A);
     end % function opLDL
 
@@ -89,4 +94,20 @@ classdef opLDL < opFactorization
 
   end % methods - public
 
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  % Methods - Protected
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  methods( Access = protected )
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % solve
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    function y = solve(op, x, mode)
+       % L*D*L' = A(p,p), which is Hermitian.
+       y = zeros(size(x));
+       y(op.p,:) = op.L' \ (op.D \ (op.L \ x(op.p,:)));
+    end % function solve
+
+  end % methods - protected
+
 end % classdef
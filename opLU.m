@@ -35,6 +35,11 @@ classdef opLU < opFactorization
     U             % Upper triangular factor
   end
 
+  properties( Access = private )
+    p             % Row permutation vector
+    q             % Column permutation vector
+  end
+
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Methods - Public
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -60,31 +65,32 @@ classdef opLU < opFactorization
       [op.L, op.U, p, q] = lu(B, 'vector');
       op.P            = opPermutation(p);
       op.Q            = opPermutation(q);
-      op.Ainv         = op.Q * inv(op.U) * inv(op.L) * op.P;
+      op.p            = p;
+      op.q            = q;
+      op.Ainv         = op.Q' * inv(op.U) * inv(op.L) * op.P;
       op.cflag        = ~isreal(A);
     end % function opLU
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % transpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = transpose(op)
-       opOut = op.P' * inv(op.L.') * inv(op.U.') * op.Q';
-    end
+  end % methods - public
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % conj
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = conj(op)
-       opOut = op.Q * inv(conj(op.U)) * inv(conj(op.L)) * op.P;
-    end
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  % Methods - Protected
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  methods( Access = protected )
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % ctranpose
+    % solve
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = ctranspose(op)
-       opOut = op.P' * inv(op.L') * inv(op.U') * op.Q';
-    end
+    function y = solve(op, x, mode)
+       % L*U = A(p,q)
+       y = zeros(size(x));
+       if mode == 1
+          y(op.q,:) = op.U \ (op.L \ x(op.p,:));
+       else
+          y(op.p,:) = op.L' \ (op.U' \ x(op.q,:));
+       end
+    end % function solve
 
-  end % methods - public
+  end % methods - protected
 
 end % classdef
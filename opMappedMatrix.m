@@ -0,0 +1,336 @@
+classdef opMappedMatrix < opSpot
+%OPMAPPEDMATRIX   Operator for a matrix stored in a file.
+%
+%   opMappedMatrix(FILENAME,M,N) creates an operator for the M-by-N
+%   matrix whose entries are stored in FILENAME as doubles in
+%   column-major order. The file is memory-mapped and never read into
+%   memory as a whole, so the matrix may be larger than the available
+%   memory.
+%
+%   opMappedMatrix(FILENAME,M,N,'key',VAL,...) sets one or more of the
+%   following options:
+%
+%   'format'     'dense'   layout of the file: 'dense', 'csc' or 'csr'.
+%                          See spot.utils.writeMapped for a description
+%                          of the formats.
+%   'precision'  'double'  class of the stored values, 'double' or
+%                          'single'.
+%   'offset'     0         number of bytes preceding the data.
+%   'tilesize'   2^26      approximate size in bytes of each tile.
+%   'readahead'  true      read the next tile while the current one is
+%                          applied. This requires spotparams('parallel')
+%                          to be 'threads' or 'processes'.
+%
+%   Products are formed one tile at a time. A tile is a block of
+%   consecutive columns (for the 'dense' and 'csc' formats) or rows
+%   (for 'csr') taking about 'tilesize' bytes in the file. Every tile
+%   is read once per product, whatever the number of columns of the
+%   input, so the memory used by a product is bounded by a few tiles in
+%   addition to the input and output. With read-ahead enabled the next
+%   tile is read on the pool of spotparams('parallel') while the current
+%   one is applied in the client; when no pool is available the tiles
+%   are read in turn.
+%
+%   Example: write a matrix to disk and solve a least-squares problem:
+%
+%       spot.utils.writeMapped('A.bin',A,'csc');
+%       B = opMappedMatrix('A.bin',size(A,1),size(A,2),'format','csc');
+%       x = lsqr(B,b);
+%
+%   See also opMatrix, spot.utils.writeMapped, memmapfile, spotparams.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Properties
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    properties (SetAccess = private)
+       filename  = '';      % File with the matrix
+       format    = 'dense'; % 'dense', 'csc' or 'csr'
+       precision = 'double';% Class of the stored values
+       readahead = true;    % Read the next tile during each product
+       tiles     = [];      % Tiles: [first last firstentry lastentry]
+    end
+
+    properties (Access = private)
+       src   = struct();    % Description of the file for the readers
+       ptr   = [];          % Column or row pointers (sparse formats)
+       maps  = struct();    % Memory maps of the indices and values
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Methods
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    methods
+
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function op = opMappedMatrix(filename,m,n,varargin)
+       %opMappedMatrix  Constructor.
+          import spot.utils.*
+
+          if nargin < 3
+             error('At least three arguments must be specified.')
+          end
+          if ~ischar(filename) || ~exist(filename,'file')
+             error('File %s does not exist.',filename);
+          end
+          if ~isposintscalar(m) || ~isposintscalar(n)
+             error('Dimensions must be positive integers.');
+          end
+
+          opts = parseOptions(varargin,{}, ...
+                    {'format','precision','offset','tilesize','readahead'});
+          format    = lower(getOption(opts,'format','dense'));
+          precision = lower(getOption(opts,'precision','double'));
+          offset    = getOption(opts,'offset',0);
+          tilesize  = getOption(opts,'tilesize',2^26);
+          readahead = getOption(opts,'readahead',true);
+
+          switch precision
+             case 'double', bytes = 8;
+             case 'single', bytes = 4;
+             otherwise
+                error('Precision must be ''double'' or ''single''.');
+          end
+
+          % Map the pointers and determine the location of the indices
+          % and values in the file.
+          src.filename  = filename;
+          src.format    = format;
+          src.precision = precision;
+          src.m         = m;
+          src.n         = n;
+          switch format
+             case 'dense'
+                nz  = m*n;
+                ptr = [];
+                src.indoffset = [];
+                src.valoffset = offset;
+                nouter = n;
+                entry  = bytes;
+             case {'csc','csr'}
+                if strcmp(format,'csc'), nouter = n; else nouter = m; end
+                map = memmapfile(filename,'Format','int64', ...
+                                 'Offset',offset,'Repeat',nouter+1, ...
+                                 'Writable',false);
+                ptr = double(map.Data);
+                nz  = ptr(end);
+                src.indoffset = offset + 8*(nouter+1);
+                src.valoffset = src.indoffset + 8*nz;
+                entry = 8 + bytes;
+             otherwise
+                error('Unknown format %s.',format);
+          end
+
+          info = dir(filename);
+          if info.bytes < src.valoffset + bytes*nz
+             error('File %s is too small for a %d-by-%d %s matrix.', ...
+                   filename,m,n,format);
+          end
+
+          % Memory maps of the indices and values.
+          maps.val = [];
+          maps.ind = [];
+          if nz > 0
+             maps.val = memmapfile(filename,'Format',precision, ...
+                                   'Offset',src.valoffset, ...
+                                   'Repeat',nz,'Writable',false);
+          end
+          if nz > 0 && ~isempty(ptr)
+             maps.ind = memmapfile(filename,'Format','int64', ...
+                                   'Offset',src.indoffset, ...
+                                   'Repeat',nz,'Writable',false);
+          end
+
+          % Divide the columns or rows into tiles.
+          if strcmp(format,'dense')
+             inner = max(1,floor(tilesize / (m*entry)));
+             first = (1:inner:n)';
+             last  = [first(2:end)-1; n];
+             tiles = [first, last, (first-1)*m+1, last*m];
+          else
+             % A new tile starts whenever the number of preceding
+             % nonzeros passes a multiple of the tile size.
+             inner = max(1,floor(tilesize / entry));
+             id    = floor(ptr(1:nouter) / inner);
+             first = find([true; diff(id) > 0]);
+             last  = [first(2:end)-1; nouter];
+             tiles = [first, last, ptr(first)+1, ptr(last+1)];
+          end
+
+          % Construct operator
+          op = op@opSpot('MappedMatrix', m, n);
+          op.sweepflag = true;
+          op.filename  = filename;
+          op.format    = format;
+          op.precision = precision;
+          op.readahead = readahead;
+          op.tiles     = tiles;
+          op.src       = src;
+          op.ptr       = ptr;
+          op.maps      = maps;
+       end % function opMappedMatrix
+
+    end % Methods
+
+
+    methods ( Access = protected )
+
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function y = multiply(op,x,mode)
+       %multiply  Multiply operator with a block of vectors.
+          [m,n] = size(op);
+          k     = size(x,2);
+          ntile = size(op.tiles,1);
+          byrow = strcmp(op.format,'csr');
+
+          if mode == 1
+             y = zeros(m,k);
+          else
+             y = zeros(n,k);
+          end
+
+          % Read the first tile, and from then on read each tile while
+          % the previous one is applied.
+          pool = [];
+          if op.readahead && ntile > 1
+             pool = spot.utils.getPool();
+          end
+          next = requestTile_intrnl(op,pool,1);
+
+          for t=1:ntile
+             B = receiveTile_intrnl(op,next,t);
+             if t < ntile
+                next = requestTile_intrnl(op,pool,t+1);
+             end
+
+             J = op.tiles(t,1):op.tiles(t,2);
+             if byrow == (mode == 1)
+                % Tile gives a block of rows of the result
+                if mode == 1
+                   y(J,:) = B * x;
+                else
+                   y(J,:) = B' * x;
+                end
+             else
+                % Tile contributes to all rows of the result
+                if mode == 1
+                   y = y + B * x(J,:);
+                else
+                   y = y + B' * x(J,:);
+                end
+             end
+          end
+       end % function multiply
+
+    end % methods
+
+end % Classdef
+
+
+%=======================================================================
+
+
+function next = requestTile_intrnl(op,pool,t)
+% Submit the read of tile t to the pool. Without a pool the tile is
+% read when it is received.
+
+   next = [];
+   if ~isempty(pool)
+      try
+         next = parfeval(pool,@readTile_intrnl,1,op.src, ...
+                         op.tiles(t,:),tileCounts_intrnl(op,t),[]);
+      catch
+         next = [];
+      end
+   end
+end
+
+
+%=======================================================================
+
+
+function B = receiveTile_intrnl(op,next,t)
+% Return tile t, read either on the pool or from the memory maps.
+
+   if ~isempty(next)
+      try
+         B = fetchOutputs(next);
+         return
+      catch
+         % Read the tile in the client instead.
+      end
+   end
+   B = readTile_intrnl(op.src,op.tiles(t,:),tileCounts_intrnl(op,t),op.maps);
+end
+
+
+%=======================================================================
+
+
+function c = tileCounts_intrnl(op,t)
+% Number of nonzeros in each column or row of tile t.
+
+   if isempty(op.ptr)
+      c = [];
+   else
+      c = diff(op.ptr(op.tiles(t,1):op.tiles(t,2)+1));
+   end
+end
+
+
+%=======================================================================
+
+
+function B = readTile_intrnl(src,tile,counts,maps)
+% Read one tile as a full or sparse matrix. The entries are taken from
+% the memory maps when given, and read from the file otherwise.
+
+   p0 = tile(3);
+   p1 = tile(4);
+   sparsefmt = ~strcmp(src.format,'dense');
+
+   if p1 < p0
+      % Tile without nonzeros
+      val = zeros(0,1);
+      ind = zeros(0,1,'int64');
+   elseif isempty(maps)
+      fid = fopen(src.filename,'r');
+      if fid < 0, error('Cannot open %s.',src.filename); end
+      cleanup = onCleanup(@() fclose(fid));
+      fseek(fid,src.valoffset + (p0-1)*sizeof_intrnl(src.precision),'bof');
+      val = fread(fid,p1-p0+1,['*' src.precision]);
+      if sparsefmt
+         fseek(fid,src.indoffset + (p0-1)*8,'bof');
+         ind = fread(fid,p1-p0+1,'*int64');
+      end
+   else
+      val = maps.val.Data(p0:p1);
+      if sparsefmt
+         ind = maps.ind.Data(p0:p1);
+      end
+   end
+   val = double(val);
+
+   nt = tile(2) - tile(1) + 1;
+   switch src.format
+      case 'dense'
+         B = reshape(val,src.m,nt);
+      case 'csc'
+         B = sparse(double(ind)+1,repelem((1:nt)',counts(:)),val,src.m,nt);
+      case 'csr'
+         B = sparse(repelem((1:nt)',counts(:)),double(ind)+1,val,nt,src.n);
+   end
+end
+
+
+%=======================================================================
+
+
+function b = sizeof_intrnl(precision)
+   if strcmp(precision,'single'), b = 4; else b = 8; end
+end
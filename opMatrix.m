@@ -5,6 +5,11 @@ classdef opMatrix < opSpot
 %   matrix-vector multiplication with matrix A. The optional parameter
 %   DESCRIPTION can be used to override the default operator name when
 %   printed.
+%
+%   When A is sparse, its conjugate transpose is formed on the first
+%   adjoint product or solve and kept with the operator, so that
+%   adjoint products walk the compressed columns of A' instead of
+%   transposing A on every call.
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -79,6 +84,8 @@ classdef opMatrix < opSpot
        %multiply  Multiply operator with a vector.
           if mode == 1
               y = op.matrix * x;
+           elseif issparse(op.matrix)
+              y = ctransposed_intrnl(op) * x;
            else
               y = op.matrix' * x;
            end
@@ -89,6 +96,8 @@ classdef opMatrix < opSpot
        %divide  Solve a linear system with the operator.
           if mode == 1
              x = op.matrix \ b;
+          elseif issparse(op.matrix)
+             x = ctransposed_intrnl(op) \ b;
           else
              x = op.matrix' \ b;
           end
@@ -98,3 +107,18 @@ classdef opMatrix < opSpot
 end % methods
    
 end % Classdef
+
+
+%=======================================================================
+
+
+function At = ctransposed_intrnl(op)
+% Conjugate transpose of the matrix, formed once and stored in the
+% counter, which is shared by all copies of the operator.
+
+   c = op.counter;
+   if ~isfield(c.cache,'ctranspose')
+      c.cache.ctranspose = op.matrix';
+   end
+   At = c.cache.ctranspose;
+end
@@ -0,0 +1,301 @@
+classdef opPartialDFT < opSpot
+%OPPARTIALDFT  Selected rows of the discrete Fourier transform.
+%
+%   opPartialDFT(N,IDX) creates an operator that returns the entries
+%   IDX of the unitary DFT of vectors of length N. It is equivalent to
+%   opRestriction(N,IDX)*opDFT(N), but only the selected frequencies
+%   are computed, and the adjoint does not form the zero-filled
+%   spectrum when this is cheaper.
+%
+%   opPartialDFT(N,IDX,CENTERED), with CENTERED set to true, selects the
+%   entries from the centered DFT, as given by opDFT(N,true).
+%
+%   opPartialDFT([M N],IDX,CENTERED) selects entries IDX from the
+%   vectorized two-dimensional DFT of M-by-N matrices, as given by
+%   opDFT2(M,N,CENTERED).
+%
+%   opPartialDFT(DIMS,IDX,CENTERED,METHOD) sets the method used along
+%   each dimension:
+%
+%   'full'    compute the full FFT and select the frequencies;
+%   'pruned'  split the transform of length N = P*Q into Q transforms
+%             of length P, followed by a length-Q sum for each
+%             selected frequency (and the reverse for the adjoint);
+%   'direct'  evaluate the selected frequencies by a matrix product;
+%   'auto'    choose the cheapest of the above, based on the number of
+%             selected frequencies (default).
+%
+%   The full and direct methods are the limiting cases Q = 1 and Q = N
+%   of the pruned method. With 'auto' the factor Q minimizes the
+%   estimated cost N*log2(N/Q) + 2*K*Q, where K is the number of
+%   selected frequencies, so that low sampling densities use the direct
+%   or pruned methods and high densities the full FFT.
+%
+%   Products of opRestriction or opMask with opDFT or opDFT2 use this
+%   operator automatically.
+%
+%   See also opDFT, opDFT2, opRestriction, opMask.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   % Properties
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   properties ( SetAccess = private, GetAccess = public )
+      inputdims         % Dimensions of the input
+      index             % Selected entries of the spectrum
+      centered          % Flag if the spectrum is centered
+      method            % Method used along each dimension
+   end % properties
+
+   properties ( Access = private )
+      plans             % Transform plan for each dimension
+      grid              % Position of each entry in the 2-D grid
+   end % properties
+
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   % Methods - public
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   methods
+
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      % opPartialDFT. Constructor.
+      %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+      function op = opPartialDFT(dims,idx,centered,method)
+         if nargin < 2 || nargin > 4
+            error('Invalid number of arguments to opPartialDFT.');
+         end
+         if nargin < 3 || isempty(centered), centered = false; end
+         if nargin < 4 || isempty(method),   method   = 'auto'; end
+         if ~spot.utils.isposintmat(dims) || numel(dims) > 2
+            error('Dimensions must be one or two positive integers.');
+         end
+         if ~any(strcmp(method,{'auto','full','pruned','direct'}))
+            error('Unknown method %s.',method);
+         end
+
+         dims = dims(:)';
+         N    = prod(dims);
+         idx  = full(idx(:));
+         if islogical(idx)
+            if length(idx) > N
+               error('Index exceeds operator dimensions.');
+            end
+            idx = find(idx);
+         elseif spot.utils.isposintmat(idx) || isempty(idx)
+            if ~isempty(idx) && max(idx) > N
+               error('Index exceeds operator dimensions.');
+            end
+         else
+            error('Subscript indices must either be real positive integers or logicals.');
+         end
+
+         % Frequencies of the selected entries along each dimension
+         if isscalar(dims)
+            K = {frequency_intrnl(idx,dims,centered)};
+         else
+            [i1,i2] = ind2sub(dims,idx);
+            K = {frequency_intrnl(i1,dims(1),centered), ...
+                 frequency_intrnl(i2,dims(2),centered)};
+         end
+
+         % Plan each dimension. In two dimensions the transforms are
+         % restricted to the distinct frequencies along each dimension,
+         % and the selected entries are taken from the resulting grid.
+         plans = cell(1,numel(dims));
+         grid  = [];
+         if isscalar(dims)
+            plans{1} = plan_intrnl(dims,K{1},method);
+         else
+            [u1,~,g1] = unique(K{1});
+            [u2,~,g2] = unique(K{2});
+            plans{1}  = plan_intrnl(dims(1),u1,method);
+            plans{2}  = plan_intrnl(dims(2),u2,method);
+            grid      = [g1(:), g2(:)];
+         end
+
+         op = op@opSpot('PartialDFT',length(idx),N);
+         op.cflag     = true;
+         op.sweepflag = true;
+         op.inputdims = dims;
+         op.index     = idx;
+         op.centered  = logical(centered);
+         op.method    = cellfun(@(p) p.method,plans,'UniformOutput',false);
+         op.plans     = plans;
+         op.grid      = grid;
+      end % function opPartialDFT
+
+   end % methods - public
+
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   % Methods - protected
+   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+   methods( Access = protected )
+
+      function y = multiply(op,x,mode)
+         x = full(x);
+         if isscalar(op.inputdims)
+            if mode == 1
+               y = forward_intrnl(op.plans{1},x);
+            else
+               y = adjoint_intrnl(op.plans{1},x);
+            end
+            return
+         end
+
+         % Two-dimensional transform, one column at a time
+         m  = op.inputdims(1);
+         n  = op.inputdims(2);
+         p1 = op.plans{1};
+         p2 = op.plans{2};
+         s1 = numel(p1.K);
+         s2 = numel(p2.K);
+         if mode == 1
+            y = zeros(op.m,size(x,2));
+            for j=1:size(x,2)
+               X = forward_intrnl(p2,reshape(x(:,j),m,n).');
+               X = forward_intrnl(p1,X.');
+               y(:,j) = X(sub2ind([s1 s2],op.grid(:,1),op.grid(:,2)));
+            end
+         else
+            y = zeros(op.n,size(x,2));
+            for j=1:size(x,2)
+               X = full(sparse(op.grid(:,1),op.grid(:,2),x(:,j),s1,s2));
+               X = adjoint_intrnl(p1,X);
+               X = adjoint_intrnl(p2,X.');
+               y(:,j) = reshape(X.',m*n,1);
+            end
+         end
+      end % function multiply
+
+   end % methods - protected
+
+end % classdef
+
+
+%=======================================================================
+
+
+function K = frequency_intrnl(i,n,centered)
+% Frequency (from 0 to n-1) at position i of the spectrum.
+
+   K = i(:) - 1;
+   if centered
+      K = mod(K - floor(n/2),n);
+   end
+end
+
+
+%=======================================================================
+
+
+function p = plan_intrnl(N,K,method)
+% Choose the factor Q of N used for the transform of length N, and
+% precompute the twiddle factors for the selected frequencies K.
+
+   maxtw = 2^22;     % Maximum number of precomputed twiddle factors
+   k     = numel(K);
+
+   D = divisors_intrnl(N);
+   switch method
+      case 'full'
+         Q = 1;
+      case 'direct'
+         Q = N;
+      otherwise
+         % Restrict to factors whose twiddle factors fit in memory.
+         D = D(D == 1 | D*k <= maxtw);
+         if strcmp(method,'pruned') && any(D > 1 & D < N)
+            D = D(D > 1 & D < N);
+         end
+         cost = N*log2(N./D) + 2*k*D;
+         cost(D == N) = k*N;   % Matrix product
+         [~,i] = min(cost);
+         Q = D(i);
+   end
+
+   p.N = N;
+   p.K = K(:);
+   p.Q = Q;
+   p.P = N/Q;
+   if Q == 1
+      p.method = 'full';
+      p.S = sparse(p.K+1,1:k,1,N,k);
+   else
+      if Q == N
+         p.method = 'direct';
+      else
+         p.method = 'pruned';
+         p.r = mod(p.K,p.P) + 1;
+         p.R = sparse(1:k,p.r,1,k,p.P);
+      end
+      p.Tw = exp(-2i*pi*mod((0:Q-1)'*p.K',N)/N);
+   end
+end
+
+
+%=======================================================================
+
+
+function y = forward_intrnl(p,x)
+% Selected frequencies of the unitary DFT of the columns of x.
+
+   if p.Q == 1
+      y = fft(x,[],1);
+      y = y(p.K+1,:);
+   elseif p.Q == p.N
+      y = p.Tw.' * x;
+   else
+      % Transforms of length P of the Q interleaved subsequences,
+      % followed by the twiddled sums for the selected frequencies.
+      y = zeros(numel(p.K),size(x,2));
+      for j=1:size(x,2)
+         F = fft(reshape(x(:,j),p.Q,p.P),[],2);
+         y(:,j) = sum(F(:,p.r) .* p.Tw, 1).';
+      end
+   end
+   y = y / sqrt(p.N);
+end
+
+
+%=======================================================================
+
+
+function y = adjoint_intrnl(p,x)
+% Adjoint of forward_intrnl.
+
+   if p.Q == 1
+      y = ifft(full(p.S * x),[],1) * p.N;
+   elseif p.Q == p.N
+      y = conj(p.Tw) * x;
+   else
+      % Twiddled inputs are gathered by residue modulo P, followed by
+      % inverse transforms of length P.
+      y = zeros(p.N,size(x,2));
+      for j=1:size(x,2)
+         G = bsxfun(@times,conj(p.Tw),x(:,j).') * p.R;
+         y(:,j) = reshape(ifft(G,[],2) * p.P, p.N, 1);
+      end
+   end
+   y = y / sqrt(p.N);
+end
+
+
+%=======================================================================
+
+
+function d = divisors_intrnl(N)
+% Sorted divisors of N.
+
+   d = 1;
+   if N == 1, return, end
+   f = factor(N);
+   for q = unique(f)
+      d = d(:) * q.^(0:sum(f == q));
+   end
+   d = sort(d(:))';
+end
@@ -48,6 +48,7 @@ classdef opPermutation < opSpot
           end
           op.linear = 1;
           op.cflag  = false;
+          op.sweepflag = true;
        end % function opPermutation
 
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -66,9 +67,10 @@ classdef opPermutation < opSpot
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function y = multiply(op,x,mode)
           if mode == 1
-             y = x(op.p);
+             y = x(op.p,:);
           else
-             y(op.p) = x;
+             y = zeros(size(x),class(x));
+             y(op.p,:) = x;
           end
         end % function multiply
 
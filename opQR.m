@@ -31,6 +31,11 @@ classdef opQR < opFactorization
     R             % Lower triangular factor
   end
 
+  properties( Access = private )
+    p             % Permutation vector
+    fullrank      % Whether R has full column rank
+  end
+
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Methods - Public
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -54,31 +59,45 @@ classdef opQR < opFactorization
       op.A            = opMatrix(B);
       [op.Q, op.R, p] = qr(B, 'vector');
       op.P            = opPermutation(p);
+      op.p            = p;
+      % Full column rank up to a tolerance on the pivoted diagonal of R
+      op.fullrank     = m >= n && n > 0 && ...
+         all(abs(diag(op.R(1:n,1:n))) > max(size(op.R))*eps(abs(op.R(1,1))));
       op.Ainv         = op.P' * opPInverse(op.R) * op.Q';
       op.cflag        = ~isreal(A);
     end % function opQR
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % transpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = transpose(op)
-       opOut = conj(op.Q) * opPInverse(op.R).' * op.P;
-    end
+  end % methods - public
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % conj
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = conj(op)
-       opOut = op.P' * conj(opPInverse(op.R)) * op.Q.';
-    end
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  % Methods - Protected
+  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+  methods( Access = protected )
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % ctranpose
+    % solve
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = ctranspose(op)
-       opOut = op.Q * opPInverse(op.R)' * op.P;
-    end
+    function y = solve(op, x, mode)
+       % Q*R = A(:,p). With full column rank the pseudo-inverse is
+       % applied by a triangular solve with the leading block of R.
+       if ~op.fullrank
+          if mode == 1
+             y = op.Ainv * x;
+          else
+             y = op.Ainv' * x;
+          end
+          return
+       end
+       n  = size(op.R,2);
+       R1 = op.R(1:n,1:n);
+       if mode == 1
+          y = zeros(n,size(x,2));
+          y(op.p,:) = R1 \ (op.Q(:,1:n)' * x);
+       else
+          y = op.Q(:,1:n) * (R1' \ x(op.p,:));
+       end
+    end % function solve
 
-  end % methods - public
+  end % methods - protected
 
 end % classdef
@@ -23,6 +23,7 @@ classdef opRestriction < opSpot
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     properties (SetAccess = private)
        funHandle = []; % Multiplication function
+       index     = []; % Selected entries
     end % Properties
 
 
@@ -76,6 +77,7 @@ classdef opRestriction < opSpot
           % Construct operator
           op = op@opSpot('Restriction', m, n);
           op.funHandle = fun;
+          op.index     = idx;
        end % Constructor
 
     end % Methods
@@ -11,6 +11,12 @@ classdef opSparseBinary < opSpot
 %   "Sparse recovery using sparse random matrices", MIT CSAIL TR
 %   2008-001, January 2008, http://hdl.handle.net/1721.1/40089
 %
+%   Only the row indices of the nonzeros are stored until they are
+%   needed: the adjoint gathers and sums the entries of the input at
+%   these rows. The sparse matrix is formed on the first forward product
+%   or request of the MATRIX property, and is then kept with the
+%   operator and used for all forward products.
+%
 %   Note that opSparseBinary calls RANDPERM and thus changes the state
 %   of RAND.
 %
@@ -26,7 +32,11 @@ classdef opSparseBinary < opSpot
     % Properties
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     properties (SetAccess = private)
-       matrix = []; % Sparse matrix representation
+       rows = [];   % Row indices of the nonzeros, one column per column
+    end % Properties
+
+    properties (Dependent = true, SetAccess = private)
+       matrix;      % Sparse matrix representation
     end % Properties
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -42,14 +52,17 @@ classdef opSparseBinary < opSpot
           if nargin < 2
              error('At least two parameters must be specified.')
           end
+          if nargin < 3, d = 8; end
           
           % Don't allow more than m nonzeros per column (obviously).
           d = min(d,m);
 
-          % Preallocate row pointers.
-          ia = zeros(d*n,1);
-          ja = zeros(d*n,1);
-          va =  ones(d*n,1);
+          % Preallocate row indices.
+          if m < intmax('uint32')
+             ia = zeros(d,n,'uint32');
+          else
+             ia = zeros(d,n);
+          end
 
           for k = 1:n  % Loop over each column.
 
@@ -62,20 +75,37 @@ classdef opSparseBinary < opSpot
                 p = p(1:d);
              end
                 
-             % Indices for start and end of the k-th column.
-             colbeg = 1+(k-1)*d;
-             colend = colbeg + d - 1;
-
-             % Populate the row and column indices.
-             ia(colbeg:colend) = p;
-             ja(colbeg:colend) = k;
+             % Populate the row indices.
+             ia(:,k) = p;
           end
-          A  = sparse(ia,ja,va,m,n);
 
           % Construct operator
           op = op@opSpot('SparseBinary', m, n);
-          op.matrix = A;
+          op.sweepflag = true;
+          op.rows = ia;
        end % Constructor
+
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Matrix
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function A = get.matrix(op)
+          cache = op.counter.cache;
+          if isfield(cache,'matrix')
+             A = cache.matrix;
+             return
+          end
+          [d,n] = size(op.rows);
+          A = sparse(double(op.rows(:)),repelem((1:n)',d),1,op.m,n);
+          c = op.counter;
+          c.cache.matrix = A;
+       end
+
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Double
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function A = double(op)
+          A = op.matrix;
+       end
                  
     end % Methods
 
@@ -85,9 +115,14 @@ classdef opSparseBinary < opSpot
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function y = multiply(op,x,mode)
           if mode == 1
+             % A scatter needs index temporaries of size d*n*k, so use
+             % the cached sparse matrix instead.
              y = op.matrix * x;
           else
-             y = op.matrix'* x;
+             % Sum the entries of x at the rows of each column.
+             [d,n] = size(op.rows);
+             k     = size(x,2);
+             y = reshape(sum(reshape(full(x(op.rows,:)),d,n,k),1),n,k);
           end
        end % Multiply
 
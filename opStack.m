@@ -125,6 +125,10 @@ classdef opStack < opSpot
        % Multiply
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function y = multiply(op,x,mode)
+          if ~strcmp(spotparams('parallel'),'off')
+             y = multiplyParallel(op,x,mode);
+             return
+          end
           if mode == 1
              y = zeros(op.m,1);
              k = 0;
@@ -146,6 +150,30 @@ classdef opStack < opSpot
           end
        end % Multiply          
 
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       % Multiply with the children evaluated concurrently
+       %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+       function y = multiplyParallel(op,x,mode)
+          if mode == 1
+             y = spot.utils.applyChildren(op.children,x,1);
+             y = vertcat(y{:});
+          else
+             nops = length(op.children);
+             xs   = cell(1,nops);
+             k    = 0;
+             for i=1:nops
+                s     = size(op.children{i},1);
+                xs{i} = x(k+1:k+s);
+                k     = k + s;
+             end
+             ys = spot.utils.applyChildren(op.children,xs,2);
+             y  = zeros(op.n,1);
+             for i=1:nops
+                y = y + ys{i};
+             end
+          end
+       end % MultiplyParallel
+
     end % Methods
    
 end % Classdef
@@ -100,6 +100,11 @@ classdef opSum < opSpot
        % Multiply
        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
        function y = multiply(op,x,mode)
+           if ~strcmp(spotparams('parallel'),'off')
+              y = spot.utils.applyChildren(op.children,x,mode);
+              y = y{1} + y{2};
+              return
+           end
            y =     applyMultiply(op.children{1},x,mode);
            y = y + applyMultiply(op.children{2},x,mode);
         end % Multiply
@@ -119,20 +119,19 @@ classdef opToeplitz < opSpot
                 n = length(r);
                 
                 % Generate the entries of the matrix
-                v  = [c;r(end:-1:2)];
-                df = fft(v);
+                df = fft([c;r(end:-1:2)]);
 
                 if normalized
+                   % Column i holds v(i:i+m-1), so its squared norm is
+                   % a difference of cumulative sums.
                    v = [c(end:-1:1);r(2:end)];
-                   s = zeros(n,1);
-                   for i=1:n
-                      s(i) = 1 / sqrt(sum(abs(v(i:i+m-1)).^2));
-                   end
+                   w = [0; cumsum(abs(v).^2)];
+                   s = 1 ./ sqrt(w(m+1:m+n) - w(1:n));
                 else
                    s = 1;
                 end
 
-                if isreal(v)
+                if isreal(c) && isreal(r)
                    fun = @(x,mode) opToeplitz_intrnl(df,s,m,n,x,mode);
                    cflag = false;
                 else
@@ -32,6 +32,10 @@ classdef opiChol < opFactorization
     L             % Lower triangular incomplete factor
   end
 
+  properties( Access = private )
+    Lt            % Conjugate transpose of L
+  end
+
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Methods - Public
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -59,31 +63,11 @@ classdef opiChol < opFactorization
       end
       opts.shape   = 'lower';
       op.L         = ichol(B, opts);
+      op.Lt        = op.L';
       op.Ainv      = inv(op.L') * inv(op.L);
       op.cflag     = ~isreal(A);
     end % function opiChol
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % transpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = transpose(op)
-       opOut = inv(op.L.') * inv(op.L);
-    end
-
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % conj
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = conj(op)
-       opOut = inv(conj(op.L')) * inv(conj(op.L));
-    end
-
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % ctranpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = ctranspose(op)
-       opOut = op.Ainv;
-    end
-
   end % methods - public
 
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -91,11 +75,19 @@ classdef opiChol < opFactorization
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   methods( Access = protected )
 
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % solve
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    function y = solve(op, x, mode)
+       % L*L' approximates A, which is Hermitian.
+       y = op.trisolve(op.Lt, op.trisolve(op.L, x, 'lower', 'L'), 'upper', 'Lt');
+    end % function solve
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % divide
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     function x = divide(op, b, mode)
-       x = op.L * (op.L' * b);  % Not the same as op.A * b.
+       x = op.L * (op.Lt * b);  % Not the same as op.A * b.
     end % function divide
 
   end % methods - protected
@@ -34,6 +34,11 @@ classdef opiLU < opFactorization
     U             % Upper triangular incomplete factor
   end
 
+  properties( Access = private )
+    Lt            % Conjugate transpose of L
+    Ut            % Conjugate transpose of U
+  end
+
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   % Methods - Public
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -54,31 +59,12 @@ classdef opiLU < opFactorization
       end
       op.A         = opMatrix(B);
       [op.L, op.U] = ilu(B, varargin{:});
+      op.Lt        = op.L';
+      op.Ut        = op.U';
       op.Ainv      = inv(op.U) * inv(op.L);
       op.cflag     = ~isreal(A);
     end % function opiLU
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % transpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = transpose(op)
-       opOut = inv(op.L.') * inv(op.U.');
-    end
-
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % conj
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = conj(op)
-       opOut = inv(conj(op.U)) * inv(conj(op.L));
-    end
-
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % ctranpose
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    function opOut = ctranspose(op)
-       opOut = inv(op.L') * inv(op.U');
-    end
-
   end % methods - public
 
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -86,11 +72,28 @@ classdef opiLU < opFactorization
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   methods( Access = protected )
 
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % solve
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    function y = solve(op, x, mode)
+       % L*U approximates A.
+       if mode == 1
+          y = op.trisolve(op.U, op.trisolve(op.L, x, 'lower', 'L'), 'upper', 'U');
+       else
+          y = op.trisolve(op.Lt, op.trisolve(op.Ut, x, 'lower', 'Ut'), 'upper', 'Lt');
+       end
+    end % function solve
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % divide
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     function x = divide(op, b, mode)
-       x = op.L * (op. U * b);  % Not the same as op.A * b.
+       % Not the same as op.A * b.
+       if mode == 1
+          x = op.L * (op.U * b);
+       else
+          x = op.Ut * (op.Lt * b);
+       end
     end % function divide
 
   end % methods - protected
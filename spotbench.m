@@ -0,0 +1,353 @@
+function results = spotbench(varargin)
+%SPOTBENCH  Benchmark the products of Spot operators.
+%
+%   SPOTBENCH times forward and adjoint products of a set of Spot
+%   operators and of the Rice Wavelet Toolbox kernels, for a range of
+%   sizes, wavelet levels and filter lengths, and prints a summary in
+%   the Command Window.
+%
+%   RESULTS = SPOTBENCH(...) returns a struct array with one entry per
+%   benchmark case and mode. The fields are:
+%
+%      operator    name of the operator or kernel
+%      n           number of columns of the operator
+%      m           number of rows of the operator
+%      level       number of wavelet levels (0 if not applicable)
+%      filter      wavelet filter length (0 if not applicable)
+%      rhs         number of right-hand sides applied at once
+%      mode        'forward' or 'adjoint'
+%      time        median time per product in seconds
+%      mintime     fastest time per product in seconds
+%      throughput  input entries processed per second
+%      iobytes     size in bytes of the input and output of a product
+%
+%   IOBYTES is the whos size of the arrays passed to and returned by a
+%   product. The memory allocated within the product is not measured.
+%
+%   SPOTBENCH('key',VAL,...) sets one or more of the following options:
+%
+%   'operators'  all    cell array with a subset of 'opWavelet2',
+%                       'opConvolve', 'opToeplitz', 'opDCT', 'opHadamard',
+%                       'opKron', 'opGaussian' and 'rwt' (the mdwt and
+%                       midwt MEX kernels).
+%   'sizes'      4.^(5:8) vector lengths n. Two-dimensional operators
+%                       are applied to P-by-Q signals with P*Q = n.
+%   'levels'     [3 5]  wavelet levels (opWavelet2 and rwt only).
+%   'filters'    [4 8]  wavelet filter lengths (opWavelet2 and rwt only).
+%   'rhs'        [1 8]  numbers of right-hand sides per product.
+%   'warmup'     2      untimed products before timing each case.
+%   'repeat'     10     timed products per case.
+%   'output'     ''     file to write the results to. The format is
+%                       JSON or CSV, depending on the extension.
+%   'baseline'   ''     JSON file written by an earlier run, or a
+%                       RESULTS struct array. Each case is compared to
+%                       the matching baseline case, and cases that are
+%                       slower by more than 'threshold' are reported as
+%                       regressions. The fields 'baseline', 'ratio' and
+%                       'regression' are then added to RESULTS.
+%   'threshold'  0.1    relative slowdown flagged as a regression.
+%   'verbose'    true   print results in the Command Window.
+%
+%   Examples
+%   --------
+%   Store a baseline and compare a later run against it:
+%
+%       spotbench('output','baseline.json');
+%       spotbench('baseline','baseline.json','output','current.csv');
+%
+%   Benchmark only the wavelet transforms on 512-by-512 images:
+%
+%       spotbench('operators',{'opWavelet2','rwt'},'sizes',512^2)
+%
+%   See also spottests.
+
+%   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
+%   See the file COPYING.txt for full copyright information.
+%   Use the command 'spot.gpl' to locate this file.
+
+%   http://www.cs.ubc.ca/labs/scl/spot
+
+   import spot.utils.*
+
+   allOps = {'opWavelet2','opConvolve','opToeplitz','opDCT', ...
+             'opHadamard','opKron','opGaussian','rwt'};
+
+   opts = parseOptions(varargin,{}, ...
+             {'operators','sizes','levels','filters','rhs','warmup', ...
+              'repeat','output','baseline','threshold','verbose'});
+   operators = getOption(opts,'operators',allOps);
+   sizes     = getOption(opts,'sizes',4.^(5:8));
+   levels    = getOption(opts,'levels',[3 5]);
+   filters   = getOption(opts,'filters',[4 8]);
+   nrhs      = getOption(opts,'rhs',[1 8]);
+   warmup    = getOption(opts,'warmup',2);
+   repeat    = max(1,getOption(opts,'repeat',10));
+   output    = getOption(opts,'output','');
+   baseline  = getOption(opts,'baseline','');
+   threshold = getOption(opts,'threshold',0.1);
+   verbose   = getOption(opts,'verbose',true);
+   if ischar(operators), operators = {operators}; end
+
+   results = struct('operator',{},'n',{},'m',{},'level',{}, ...
+                    'filter',{},'rhs',{},'mode',{},'time',{}, ...
+                    'mintime',{},'throughput',{},'iobytes',{});
+
+   for i=1:length(operators)
+      name = operators{i};
+      if any(strcmp(name,{'opWavelet2','rwt'}))
+         lv = levels; fl = filters;
+      else
+         lv = 0; fl = 0;
+      end
+
+      for n=sizes(:)'
+         for level=lv(:)'
+            for filter=fl(:)'
+               try
+                  bench = benchCase_intrnl(name,n,level,filter);
+               catch err
+                  warning('SPOT:spotbench:skipped', ...
+                          'Skipping %s (n = %d): %s',name,n,err.message);
+                  continue
+               end
+               for q=nrhs(:)'
+                  r = timeCase_intrnl(bench,q,warmup,repeat);
+                  for k=1:length(r)
+                     r(k).operator = name;
+                     r(k).level    = level;
+                     r(k).filter   = filter;
+                  end
+                  results = [results, orderfields(r,results)]; %#ok<AGROW>
+               end
+            end
+         end
+      end
+   end
+
+   if ~isempty(baseline)
+      results = compare_intrnl(results,baseline,threshold);
+   end
+
+   if verbose
+      report_intrnl(results);
+   end
+
+   if ~isempty(output)
+      [~,~,ext] = fileparts(output);
+      if strcmpi(ext,'.csv')
+         writeCSV_intrnl(results,output);
+      else
+         writeJSON_intrnl(results,output);
+      end
+   end
+end % function spotbench
+
+
+%=======================================================================
+
+
+function bench = benchCase_intrnl(name,n,level,filter)
+% Construct the operator or kernel for one benchmark case. The products
+% are given as function handles acting on blocks of columns.
+
+   % Signal dimensions for two-dimensional operators
+   p = 2^floor(log2(n)/2);
+   q = floor(n/p);
+
+   switch name
+      case 'opWavelet2'
+         op = opWavelet2(p,q,'Daubechies',filter,level);
+      case 'opConvolve'
+         op = opConvolve(n,1,randn(16,1),[8 1],'cyclic');
+      case 'opToeplitz'
+         op = opToeplitz(randn(n,1));
+      case 'opDCT'
+         op = opDCT(n);
+      case 'opHadamard'
+         op = opHadamard(n);
+      case 'opKron'
+         op = opKron(opDCT(p),opDCT(q));
+      case 'opGaussian'
+         % Use the explicit mode, so that the product is timed rather
+         % than the regeneration of the matrix, and limit the number of
+         % rows to keep the matrix at 32 MB.
+         op = opGaussian(max(1,min([n,1024,floor(2^22/n)])),n,0);
+      case 'rwt'
+         h = spot.rwt.daubcqf(filter);
+         bench.m   = p*q;
+         bench.n   = p*q;
+         bench.fwd = @(X) rwtApply_intrnl(@spot.rwt.mdwt ,X,h,level,p,q);
+         bench.adj = @(X) rwtApply_intrnl(@spot.rwt.midwt,X,h,level,p,q);
+         return
+      otherwise
+         error('Unknown operator %s.',name);
+   end
+
+   [bench.m,bench.n] = size(op);
+   bench.fwd = @(X) op*X;
+   bench.adj = @(X) op'*X;
+end
+
+
+%=======================================================================
+
+
+function Y = rwtApply_intrnl(fun,X,h,level,p,q)
+% Apply an rwt kernel to each column of X.
+
+   Y = zeros(size(X));
+   for j=1:size(X,2)
+      Y(:,j) = reshape(fun(reshape(X(:,j),p,q),h,level),[],1);
+   end
+end
+
+
+%=======================================================================
+
+
+function r = timeCase_intrnl(bench,q,warmup,repeat)
+% Time the forward and adjoint products for a block of q vectors.
+
+   modes = {'forward','adjoint'};
+   funs  = {bench.fwd, bench.adj};
+   nin   = [bench.n, bench.m];
+   nout  = [bench.m, bench.n];
+
+   r = struct('n',{},'m',{},'rhs',{},'mode',{},'time',{}, ...
+              'mintime',{},'throughput',{},'iobytes',{});
+   for k=1:2
+      X = randn(nin(k),q);
+      for i=1:warmup
+         Y = funs{k}(X); %#ok<NASGU>
+      end
+      t = zeros(repeat,1);
+      for i=1:repeat
+         t0   = tic;
+         Y    = funs{k}(X);
+         t(i) = toc(t0);
+      end
+
+      s = whos('X','Y');
+      r(k).n          = bench.n;
+      r(k).m          = bench.m;
+      r(k).rhs        = q;
+      r(k).mode       = modes{k};
+      r(k).time       = median(t);
+      r(k).mintime    = min(t);
+      r(k).throughput = nin(k)*q / median(t);
+      r(k).iobytes    = sum([s.bytes]);
+      assert(size(Y,1) == nout(k));
+   end
+end
+
+
+%=======================================================================
+
+
+function results = compare_intrnl(results,baseline,threshold)
+% Compare the results to a baseline and flag regressions.
+
+   if ischar(baseline)
+      baseline = readJSON_intrnl(baseline);
+   end
+   key = @(r) sprintf('%s|%d|%d|%d|%d|%s', ...
+                      r.operator,r.n,r.level,r.filter,r.rhs,r.mode);
+   keys = arrayfun(key,baseline,'UniformOutput',false);
+
+   for i=1:length(results)
+      j = find(strcmp(key(results(i)),keys),1);
+      if isempty(j)
+         results(i).baseline   = NaN;
+         results(i).ratio      = NaN;
+         results(i).regression = false;
+      else
+         results(i).baseline   = baseline(j).time;
+         results(i).ratio      = results(i).time / baseline(j).time;
+         results(i).regression = results(i).ratio > 1 + threshold;
+      end
+   end
+end
+
+
+%=======================================================================
+
+
+function report_intrnl(results)
+% Print the results in the Command Window.
+
+   hasBase = isfield(results,'ratio');
+   fprintf('\n%-12s %9s %5s %6s %4s %-8s %11s %11s', 'operator','n', ...
+           'level','filter','rhs','mode','time (s)','entries/s');
+   if hasBase, fprintf(' %7s', 'ratio'); end
+   fprintf('\n');
+   for i=1:length(results)
+      r = results(i);
+      fprintf('%-12s %9d %5d %6d %4d %-8s %11.4e %11.4e', r.operator, ...
+              r.n,r.level,r.filter,r.rhs,r.mode,r.time,r.throughput);
+      if hasBase
+         fprintf(' %7.3f', r.ratio);
+         if r.regression, fprintf('  REGRESSION'); end
+      end
+      fprintf('\n');
+   end
+   if hasBase
+      fprintf('\n%d of %d cases regressed.\n', ...
+              nnz([results.regression]),length(results));
+   end
+   fprintf('\n');
+end
+
+
+%=======================================================================
+
+
+function writeJSON_intrnl(results,filename)
+   data.version = strtrim(fileread(fullfile(spot.path,'VERSION')));
+   data.matlab  = version;
+   data.date    = datestr(now,31);
+   data.results = results;
+   fid = fopen(filename,'w');
+   if fid < 0, error('Cannot open %s for writing.',filename); end
+   fprintf(fid,'%s',jsonencode(data));
+   fclose(fid);
+end
+
+
+%=======================================================================
+
+
+function results = readJSON_intrnl(filename)
+   data = jsondecode(fileread(filename));
+   if isfield(data,'results')
+      results = data.results;
+   else
+      results = data;
+   end
+   results = results(:)';
+end
+
+
+%=======================================================================
+
+
+function writeCSV_intrnl(results,filename)
+   fields = fieldnames(results);
+   fid = fopen(filename,'w');
+   if fid < 0, error('Cannot open %s for writing.',filename); end
+   fprintf(fid,'%s\n',strjoin(fields',','));
+   for i=1:length(results)
+      row = cell(1,length(fields));
+      for k=1:length(fields)
+         v = results(i).(fields{k});
+         if ischar(v)
+            row{k} = v;
+         elseif islogical(v)
+            row{k} = sprintf('%d',v);
+         else
+            row{k} = sprintf('%.10g',v);
+         end
+      end
+      fprintf(fid,'%s\n',strjoin(row,','));
+   end
+   fclose(fid);
+end
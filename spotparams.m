@@ -12,6 +12,29 @@ function p = spotparams(varargin)
 %   'cgshow'     false  show output from CG itns
 %   'cgdamp'     0      LSQR damping parameter
 %   'conlim'     1e8    Condition number limit on LSQR solves
+%   'cgprecision' 'double' precision of the operator products in LSQR
+%                       solves: 'double', or 'mixed' for single-precision
+%                       products with double-precision refinement
+%   'promote'    false  replace composite operators by an explicit matrix
+%                       once this is cheaper than applying them, see
+%                       spot.utils.promote
+%   'promotemem' 2^27   memory budget in bytes for each explicit matrix
+%   'profile'    false  record the time, number of columns and bytes of
+%                       every product in the operator counters, see
+%                       spot.utils.spottree/report
+%   'parallel'   'off'  evaluate the children of composite operators
+%                       concurrently: 'threads' uses the background
+%                       pool, 'processes' the current parallel pool
+%   'parmincost' 1e-3   children whose products take less time (in
+%                       seconds, on average) are evaluated in the client
+%   'levelsolve' false  solve with the incomplete factors of opiLU and
+%                       opiChol level by level, see
+%                       spot.utils.levelschedule
+%   'cachedir'   ''     directory in which constructors store their
+%                       precomputed data for reuse by later sessions,
+%                       see spot.utils.diskcache; '' disables the cache
+%   'cachemintime' 0.05 setup time (in seconds) below which the data
+%                       is recomputed instead of stored
 
 %   Copyright 2009, Ewout van den Berg and Michael P. Friedlander
 %   See the file COPYING.txt for full copyright information.
@@ -27,6 +50,15 @@ function p = spotparams(varargin)
    defopts.cgshow    = false;  % show output from CG itns
    defopts.cgdamp    = 0;      % LSQR damping parameter
    defopts.conlim    = 1e8;    % Condition number limit on LSQR solves
+   defopts.cgprecision = 'double'; % Precision of products in LSQR solves
+   defopts.promote   = false;  % Adaptive promotion to explicit matrices
+   defopts.promotemem= 2^27;   % Memory budget per promoted operator
+   defopts.profile   = false;  % Profile all operator products
+   defopts.parallel  = 'off';  % Concurrent evaluation of child operators
+   defopts.parmincost= 1e-3;   % Min. time per product for remote evaluation
+   defopts.levelsolve= false;  % Level-scheduled incomplete factor solves
+   defopts.cachedir  = '';     % Directory of the on-disk operator cache
+   defopts.cachemintime = 0.05;% Min. setup time for storing in the cache
    
    % This structure saves the default or user-modifed parameters.
    persistent savedopts
@@ -59,7 +91,7 @@ function p = spotparams(varargin)
    % The user may have changed saved option values. Save these.
    for i=1:length(validOpts)
       opti = validOpts{i};
-      if isfield(parm,opti) && parm.(opti) ~= savedopts.(opti)
+      if isfield(parm,opti) && ~isequal(parm.(opti),savedopts.(opti))
          savedopts.(opti) = parm.(opti);
       end
    end
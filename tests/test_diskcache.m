@@ -0,0 +1,98 @@
+function test_suite = test_diskcache
+%test_diskcache  Unit tests for the on-disk operator cache
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   seed = rng('default');
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function cachedir = enableCache
+   cachedir = tempname;
+   spotparams('cachedir',cachedir,'cachemintime',0);
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function disableCache(cachedir)
+   spotparams('default');
+   if exist(cachedir,'dir'), rmdir(cachedir,'s'); end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_diskcache_store_and_load(seed)
+   cachedir = enableCache;
+   cleanup  = onCleanup(@() disableCache(cachedir));
+
+   calls = 0;
+   function [a,b] = fun
+      calls = calls + 1;
+      a = magic(4);
+      b = 'abc';
+   end
+
+   [a1,b1] = spot.utils.diskcache('test',{1,'x'},@fun);
+   [a2,b2] = spot.utils.diskcache('test',{1,'x'},@fun);
+   assertEqual( 1, calls );
+   assertEqual( a1, a2 );
+   assertEqual( b1, b2 );
+   assertEqual( 1, numel(cacheFiles(cachedir)) );
+
+   % The hit flag tells loaded outputs from computed ones
+   [a4,b4,hit] = spot.utils.diskcache('test',{1,'x'},@fun,2);
+   assertTrue( hit );
+   assertEqual( 1, calls );
+   assertEqual( a1, a4 );
+   assertEqual( b1, b4 );
+   [~,~,hit] = spot.utils.diskcache('test',{3,'x'},@fun,2);
+   assertFalse( hit );
+   assertEqual( 2, calls );
+
+   % A different key is computed again
+   spot.utils.diskcache('test',{2,'x'},@fun);
+   assertEqual( 3, calls );
+
+   % Unreadable files are recomputed
+   files = cacheFiles(cachedir);
+   for i=1:length(files)
+      fid = fopen(files{i},'w'); fwrite(fid,'junk'); fclose(fid);
+   end
+   a3 = spot.utils.diskcache('test',{1,'x'},@fun);
+   assertEqual( 4, calls );
+   assertEqual( a1, a3 );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_diskcache_random_ensembles(seed)
+   cachedir = enableCache;
+   cleanup  = onCleanup(@() disableCache(cachedir));
+   m = 20; n = 30;
+
+   % The cached operators and the RNG state that follows their
+   % construction match those generated without the cache.
+   for mode = 0:5
+      rng(seed); A1 = opGaussian(m,n,mode);  s1 = rng;
+      rng(seed); A2 = opGaussian(m,n,mode);  s2 = rng;
+      assertEqual( double(A1), double(A2) );
+      assertEqual( s1, s2 );
+
+      rng(seed); B1 = opBernoulli(m,n,mode); s1 = rng;
+      rng(seed); B2 = opBernoulli(m,n,mode); s2 = rng;
+      assertEqual( double(B1), double(B2) );
+      assertEqual( s1, s2 );
+   end
+
+   % Without the cache
+   rng(seed); A1 = opGaussian(m,n,3); s1 = rng;
+   spotparams('cachedir','');
+   rng(seed); A2 = opGaussian(m,n,3); s2 = rng;
+   assertEqual( double(A1), double(A2) );
+   assertEqual( s1, s2 );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function files = cacheFiles(cachedir)
+   d = dir(fullfile(cachedir,'*.mat'));
+   files = cellfun(@(f) fullfile(cachedir,f),{d.name},'UniformOutput',false);
+end
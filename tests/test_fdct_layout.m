@@ -0,0 +1,118 @@
+function test_suite = test_fdct_layout
+%test_fdct_layout  Unit tests for the curvelet coefficient layout
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_fdct_layout_offsets(seed)
+   [C,hdr,nba] = coefficients(false);
+   L = spot.utils.fdct_layout(C);
+
+   assertEqual( 1 + nba + 2*nba, L.count );
+   assertEqual( [1; 2*ones(nba,1); 3*ones(2*nba,1)], L.scale );
+   k = 0;
+   for i = 1:length(C)
+      for j = 1:length(C{i})
+         k = k + 1;
+         assertEqual( size(C{i}{j}), L.dims(k,:) );
+         assertEqual( numel(C{i}{j}), L.offset(k+1) - L.offset(k) );
+      end
+   end
+
+   % Opposite wedges are paired, the coarse scale is not
+   assertEqual( 0, L.pair(1) );
+   assertEqual( (2:L.count)', L.pair(L.pair(2:end)) );
+   assertEqual( L.scale(2:end), L.scale(L.pair(2:end)) );
+   assertEqual( L.dims(2:end,:), L.dims(L.pair(2:end),:) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_fdct_layout_roundtrip(seed)
+   [C,hdr,nba] = coefficients(false);
+   L = spot.utils.fdct_layout(C);
+
+   x = spot.utils.fdct_c2v(C);
+   assertEqual( L.offset(end), length(x) );
+   assertEqual( x, spot.utils.fdct_c2v(C,L) );
+   assertEqual( x, spot.utils.fdct_c2v(C,length(x)) );
+
+   % Conversion back with the sizes and with the layout
+   assertCoefficientsEqual( C, spot.utils.fdct_v2c(x,hdr,1,nba) );
+   assertCoefficientsEqual( C, spot.utils.fdct_v2c(x,L) );
+
+   y = randn(size(x));
+   assertEqual( y, spot.utils.fdct_c2v(spot.utils.fdct_v2c(y,L),L) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_fdct_layout_pack(seed)
+   C = coefficients(true);
+   L = spot.utils.fdct_layout(C);
+
+   % Reference: real parts in the first half of each scale and imaginary
+   % parts in the second, scaled by sqrt(2), as in fdct_wrapping_c2r.
+   R = C;
+   for i = 2:length(C)
+      nw = length(C{i});
+      for j = 1:nw/2
+         R{i}{j}      = sqrt(2)*real(C{i}{j});
+         R{i}{j+nw/2} = sqrt(2)*imag(C{i}{j});
+      end
+   end
+   y = spot.utils.fdct_pack(C,L);
+   assertTrue( isreal(y) );
+   assertElementsAlmostEqual( spot.utils.fdct_c2v(R,L), y );
+
+   % The packing is an isometry and fdct_unpack is its inverse
+   assertElementsAlmostEqual( norm(spot.utils.fdct_c2v(C,L)), norm(y) );
+   assertCoefficientsEqual( C, spot.utils.fdct_unpack(y,L) );
+   z = randn(size(y));
+   assertElementsAlmostEqual( z, spot.utils.fdct_pack(spot.utils.fdct_unpack(z,L),L) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function [C,hdr,nba] = coefficients(cplx)
+% Coefficient structure shaped like that of a wrapping transform with
+% three scales and no wavelets at the finest scale. The wedges of each
+% scale are ordered north, east, south, west. With CPLX set, opposite
+% wedges are complex conjugates, as for the transform of a real image.
+
+   nba = 8;
+   hdr{1}{1} = [5 6];
+   hdr{2}    = {[4 3], [3 4]};
+   hdr{3}    = {[6 5], [5 6]};
+
+   C{1}{1} = randn(hdr{1}{1});
+   for i = 2:3
+      nw = nba * 2^floor((i-1)/2);
+      for j = 1:nw
+         q = ceil(4*j/nw);       % Quadrant
+         d = hdr{i}{2 - mod(q,2)};
+         if ~cplx
+            C{i}{j} = randn(d);
+         elseif j <= nw/2
+            C{i}{j} = randn(d) + 1i*randn(d);
+         else
+            C{i}{j} = conj(C{i}{j-nw/2});
+         end
+      end
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function assertCoefficientsEqual(C1,C2)
+   assertEqual( length(C1), length(C2) );
+   for i = 1:length(C1)
+      assertEqual( length(C1{i}), length(C2{i}) );
+      for j = 1:length(C1{i})
+         assertEqual( size(C1{i}{j}), size(C2{i}{j}) );
+         assertElementsAlmostEqual( C1{i}{j}, C2{i}{j} );
+      end
+   end
+end
@@ -0,0 +1,69 @@
+function test_suite = test_materialize
+%test_materialize  Unit tests for blockwise operator materialization
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_materialize_blocks(seed)
+   import spot.utils.*
+   A = randn(9,14) + 1i*randn(9,14);
+   B = opMatrix(A(:,1:7)) * opDCT(7) * opMatrix(A(1:7,:)); % wide
+   C = double(B);
+   assertElementsAlmostEqual( C, materialize(B,'blocksize',1) );
+   assertElementsAlmostEqual( C, materialize(B,'blocksize',4) );
+   assertElementsAlmostEqual( C', materialize(B','blocksize',3) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_materialize_sparse(seed)
+   import spot.utils.*
+   B = opBlockDiag(randn(5,1), opDiag(randn(4,1)));
+   S = materialize(B,'sparse','auto');
+   assertTrue( issparse(S) );
+   assertElementsAlmostEqual( full(S), materialize(B,'sparse',false) );
+   assertFalse( issparse(materialize(B,'sparse',false)) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_materialize_memory(seed)
+   import spot.utils.*
+   B = opDCT(64);
+   assertExceptionThrown( ...
+      @() materialize(B,'sparse',false,'memory',1024), ...
+      'SPOT:materialize:memory');
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_materialize_promote(seed)
+   A = randn(8,8);
+   F = opFunction(8,8,@(x,mode) slowProduct(A,x,mode));
+   B = F * opDCT(8);
+   C = double(B);
+   x = randn(8,1);
+
+   spotparams('promote',true);
+   for i=1:20
+      y = B*x;
+      z = B'*x;
+   end
+   spotparams('promote',false);
+
+   assertElementsAlmostEqual( y, C*x );
+   assertElementsAlmostEqual( z, C'*x );
+   P = B.counter.cache.promoted;
+   assertTrue( isa(P,'opMatrix') );
+   assertElementsAlmostEqual( double(P), C );
+   assertTrue( F.nprods(1) < 20 );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function y = slowProduct(A,x,mode)
+   pause(1e-3);
+   if mode == 1, y = A*x; else y = A'*x; end
+end
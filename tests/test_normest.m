@@ -52,6 +52,22 @@ function test_normest
    A = opEmpty(0,13);
    assertEqual(normest(A),0);
 
+   % Block size and cached estimate
+   A = randn(40,30);
+   B = opMatrix(A);
+   assertElementsAlmostEqual(normest(B,tol,1),norm(A),'relative',1e-4);
+   C = opMatrix(A);
+   e = normest(C,tol,4);
+   nprods = C.nprods;
+   assertEqual(normest(C),e);
+   assertEqual(normest(C'),e);
+   assertEqual(C.nprods,nprods);
+
+   % The start vector lies in the null space of [1 -1]
+   B = opMatrix([1 -1]);
+   assertElementsAlmostEqual(normest(B,tol,1),sqrt(2),'relative',1e-4);
+   assertEqual(normest(opZeros(3,4),tol,1),0);
+
    % Nested function
    function checkequal(A,B)
       assertElementsAlmostEqual(normest(A ),normest(B ),'relative',tol,tol);
@@ -44,3 +44,23 @@ function test_opBernoulli_mode23(seed)
 
    assertElementsAlmostEqual( double(A1), double(A2) );
 end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opBernoulli_mode45_packed(seed)
+   m = 13; n = 7; % m not a multiple of 8
+
+   rng(seed);  A0 = opBernoulli(m,n,0); % explicit
+   rng(seed);  A2 = opBernoulli(m,n,2); % explicit, scaled
+   rng(seed);  A4 = opBernoulli(m,n,4); % bit-packed
+   rng(seed);  A5 = opBernoulli(m,n,5); % bit-packed, scaled
+
+   x = randn(n,3);
+   y = randn(m,3) + 1i*randn(m,3);
+
+   assertEqual( double(A0), double(A4) );
+   assertElementsAlmostEqual( double(A2), double(A5) );
+   assertElementsAlmostEqual( A0 *x, A4 *x );
+   assertElementsAlmostEqual( A0'*y, A4'*y );
+   assertElementsAlmostEqual( A2 *x, A5 *x );
+   assertElementsAlmostEqual( A2'*y, A5'*y );
+end
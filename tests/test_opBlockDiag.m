@@ -45,4 +45,19 @@ function test_opBlockDiag_overlap(seed)
    ov = -(m1+1);
    D  = opBlockDiag(A,B,ov);
    assertFalse(spot.utils.dottest(D));
-end
\ No newline at end of file
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opBlockDiag_repeated(seed)
+   m = randi([2,20]); n = randi([2,20]); k = randi([2,10]);
+   A = randn(m,n) + 1i*randn(m,n);
+   w = randn(k,1);
+   D = opBlockDiag(w,opMatrix(A));
+   assertEqual( length(D.children), 1 );
+   M = kron(diag(w),A);
+   x = randn(k*n,3);
+   y = randn(k*m,3);
+   assertElementsAlmostEqual( M*x,  D*x  );
+   assertElementsAlmostEqual( M'*y, D'*y );
+   assertFalse(spot.utils.dottest(opBlockDiag(k,opDCT(n))));
+end
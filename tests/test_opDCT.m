@@ -0,0 +1,35 @@
+function test_suite = test_opDCT
+%test_opDCT  Unit tests for the DCT operators
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opDCT_against_utils(seed)
+   for n = [1 2 7 16 33]
+      A = opDCT(n);
+      x = randn(n,3) + 1i*randn(n,3);
+      assertElementsAlmostEqual( spot.utils.dct(x),  A *x );
+      assertElementsAlmostEqual( spot.utils.idct(x), A'*x );
+      assertElementsAlmostEqual( x, A'*(A*x) );
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opDCT2_multicolumn(seed)
+   m = 6; n = 9;
+   A = opDCT2(m,n);
+   x = randn(m*n,4);
+   y = A*x;
+   for i=1:4
+      X = reshape(x(:,i),m,n);
+      Y = spot.utils.dct(spot.utils.dct(X).').';
+      assertElementsAlmostEqual( Y(:), y(:,i) );
+   end
+   assertElementsAlmostEqual( x, A'*y );
+end
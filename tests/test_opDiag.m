@@ -48,3 +48,51 @@ function test_opDiag_divide(seed)
    assertEqual( D'\b, bsxfun(@ldivide,conj(d),b) )
    assertEqual( D.'\b, bsxfun(@ldivide,d,b) ) 
 end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
+function test_opDiag_diagstructured(seed)
+   A = randn(5,5); B = randn(4,4) + 1i*randn(4,4); d = randn(3,1);
+   ops = { opMatrix(A), opKron(opMatrix(A),opMatrix(B)), ...
+           blkdiag(opMatrix(A),opDiag(d),opMatrix(B)), ...
+           opBlockDiag([1;-2;3],opMatrix(B)), opMatrix(A)' + opDiag(randn(5,1)), ...
+           opMatrix(randn(6,4)), opDCT(8) };
+   for i=1:length(ops)
+      op = ops{i};
+      assertElementsAlmostEqual( diag(op), diag(double(op)) );
+      assertElementsAlmostEqual( diag(op,'method','exact','blocksize',3), ...
+                                 diag(double(op)) );
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
+function test_opDiag_diagprobe(seed)
+   n = 50;
+   T = spdiags(randn(n,4),[-2 0 1 3],n,n);
+   op = opFunction(n,n,@(x,mode) opDiagTestApply(T,x,mode));
+   assertElementsAlmostEqual( diag(op,'bandwidth',[2 3]), full(diag(T)) );
+
+   % Circular convolution
+   C = opConvolve(n,1,randn(5,1),[3 1],'cyclic');
+   assertElementsAlmostEqual( diag(C,'bandwidth',4,'periodic',true), ...
+                              diag(double(C)) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
+function test_opDiag_diagstochastic(seed)
+   n = 40;
+   A = randn(n,n) + 20*diag(1:n);
+   op = opFunction(n,n,@(x,mode) opDiagTestApply(A,x,mode));
+   [d,err] = diag(op,'tol',1e-2,'maxprods',4000);
+   assertTrue( all(abs(d - diag(A)) <= 5*err + 1e-10) );
+
+   % The estimate is exact for diagonal operators
+   D = opFunction(n,n,@(x,mode) opDiagTestApply(diag(1:n),x,mode));
+   [d,err] = diag(D,'method','stochastic');
+   assertElementsAlmostEqual( d, (1:n)' );
+   assertEqual( err, zeros(n,1) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
+function y = opDiagTestApply(A,x,mode)
+   if mode == 1, y = A*x; else y = A'*x; end
+end
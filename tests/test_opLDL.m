@@ -50,3 +50,18 @@ function test_opLDL_double
    assertElementsAlmostEqual(inv(A), B.double);
 
 end
+
+function test_opLDL_block
+
+   rng('default');
+
+   % Set up matrices and operators for problems
+   A  = randn(8,8);
+   A  = tril(A) + tril(A,-1)';
+   B  = opLDL(A);
+   X  = randn(8,3);
+
+   % Check opLDL on a block of right-hand sides
+   assertElementsAlmostEqual( A \ X, B * X );
+
+end
@@ -47,3 +47,23 @@ function test_opLU_double
    assertElementsAlmostEqual(inv(A), B.double);
 
 end
+
+function test_opLU_block
+
+   rng('default');
+
+   % Sparse matrix, so that lu also permutes the columns
+   A  = sprandn(30,30,0.1) + 10*speye(30);
+   B  = opLU(A);
+   X  = randn(30,4) + sqrt(-1) * randn(30,4);
+
+   % Check opLU on a block of right-hand sides and its adjoint
+   assertElementsAlmostEqual( A \ X, B * X );
+   assertElementsAlmostEqual( A' \ X, B' * X );
+   assertElementsAlmostEqual( A.' \ X, B.' * X );
+   assertElementsAlmostEqual( conj(A) \ X, conj(B) * X );
+
+   % The adjoints are applied by the solve in mode 2
+   assertEqual( [2 2], B.nprods );
+
+end
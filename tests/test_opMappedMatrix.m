@@ -0,0 +1,71 @@
+function test_suite = test_opMappedMatrix
+%test_opMappedMatrix  Unit tests for the file-backed matrix operator
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opMappedMatrix_formats(seed)
+   A = sprandn(23,17,0.3);
+   A(:,5) = 0;                      % empty column
+   A(7,:) = 0;                      % empty row
+   x = randn(17,3);
+   y = randn(23,3);
+
+   formats = {'dense','csc','csr'};
+   for i=1:length(formats)
+      file = [tempname '.bin'];
+      cleanup = onCleanup(@() delete(file));
+      spot.utils.writeMapped(file,A,formats{i});
+
+      % Small tiles, so that every product uses several of them
+      B = opMappedMatrix(file,23,17,'format',formats{i},'tilesize',256);
+      assertTrue( size(B.tiles,1) > 1 );
+      assertElementsAlmostEqual( A*x,  B*x );
+      assertElementsAlmostEqual( A'*y, B'*y );
+      assertElementsAlmostEqual( A*x(:,1), B*x(:,1) );
+      assertElementsAlmostEqual( A*(1i*x), B*(1i*x) );
+      clear B cleanup
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opMappedMatrix_single(seed)
+   A = randn(12,9);
+   file = [tempname '.bin'];
+   cleanup = onCleanup(@() delete(file));
+   spot.utils.writeMapped(file,A,'dense','single');
+
+   B = opMappedMatrix(file,12,9,'precision','single');
+   x = randn(9,2);
+   assertElementsAlmostEqual( double(single(A))*x, B*x, 'relative', 1e-12 );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opMappedMatrix_lsqr(seed)
+   A = randn(40,10);
+   b = randn(40,1);
+   file = [tempname '.bin'];
+   cleanup = onCleanup(@() delete(file));
+   spot.utils.writeMapped(file,A,'csr');
+
+   B = opMappedMatrix(file,40,10,'format','csr','tilesize',512);
+   x = spot.solvers.lsqr(40,10,B,b,0,1e-12,1e-12,1e8,100,0);
+   assertElementsAlmostEqual( A\b, x, 'relative', 1e-8 );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opMappedMatrix_errors(seed)
+   A = randn(5,4);
+   file = [tempname '.bin'];
+   cleanup = onCleanup(@() delete(file));
+   spot.utils.writeMapped(file,A);
+
+   assertExceptionThrown(@() opMappedMatrix(file,5,5), '');
+   assertExceptionThrown(@() opMappedMatrix([file 'x'],5,4), '');
+end
@@ -47,3 +47,19 @@ function test_opMatrix_divide
       B \ xi );
    
 end
+
+function test_opMatrix_sparse_adjoint
+   
+   rng('default');
+   
+   A = sprandn(30,20,0.2) + 1i*sprandn(30,20,0.2);
+   B = opMatrix(A);
+   C = B;                            % copies share the stored transpose
+   y = randn(30,3);
+
+   assertElementsAlmostEqual( A'*y, B'*y );
+   assertElementsAlmostEqual( A'*y, C'*y );
+   assertElementsAlmostEqual( A'*y(:,1), B'*y(:,1) );
+   assertElementsAlmostEqual( A(1:20,:)' \ y(1:20,1), ...
+                              opMatrix(A(1:20,:))' \ y(1:20,1) );
+end
@@ -0,0 +1,83 @@
+function test_suite = test_opPartialDFT
+%test_opPartialDFT  Unit tests for the partial Fourier transform
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opPartialDFT_methods(seed)
+   n   = 48;
+   idx = [3; 17; 17; 40; 1];        % includes a repeated entry
+   x   = randn(n,2) + 1i*randn(n,2);
+   y   = randn(5,2) + 1i*randn(5,2);
+   methods = {'full','pruned','direct','auto'};
+   for centered = [false true]
+      F = double(opDFT(n));
+      if centered, F = fftshift(F,1); end
+      F = F(idx,:);
+      for i=1:length(methods)
+         A = opPartialDFT(n,idx,centered,methods{i});
+         if ~strcmp(methods{i},'auto')
+            assertEqual( methods(i), A.method );
+         end
+         assertElementsAlmostEqual( F*x,  A*x );
+         assertElementsAlmostEqual( F'*y, A'*y );
+      end
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opPartialDFT_2d(seed)
+   m = 12; n = 10;
+   idx = randperm(m*n,15);
+   x   = randn(m*n,1);
+   for centered = [false true]
+      if centered
+         F = double(opDFT2(m,n,true));
+      else
+         F = double(opDFT2(m,n));
+      end
+      for method = {'full','pruned','direct'}
+         A = opPartialDFT([m n],idx,centered,method{1});
+         assertElementsAlmostEqual( F(idx,:)*x, A*x );
+         assertFalse( spot.utils.dottest(A,5) );
+      end
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opPartialDFT_density(seed)
+   % Sparse sampling avoids the full FFT, dense sampling uses it.
+   n = 4096;
+   A = opPartialDFT(n,1:4);
+   assertFalse( strcmp(A.method{1},'full') );
+   A = opPartialDFT(n,1:n/2);
+   assertEqual( {'full'}, A.method );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opPartialDFT_fused(seed)
+   % Products with restrictions and masks use the partial transform.
+   n   = 64;
+   idx = [5 9 33 60];
+   x   = randn(n,3);
+   D   = opDFT(n,true);
+   R   = opRestriction(n,idx);
+   A   = R*D;
+   Y   = fftshift(fft(x),1) / sqrt(n);
+   assertElementsAlmostEqual( Y(idx,:), A*x );
+   assertElementsAlmostEqual( D'*(R'*Y(idx,:)), A'*Y(idx,:) );
+
+   m = 8; n = 6;
+   M = opMask(m*n,[2 7 30]);
+   D = opDFT2(m,n);
+   B = M*D;
+   x = randn(m*n,1);
+   assertElementsAlmostEqual( M*(D*x), B*x );
+   assertElementsAlmostEqual( D'*(M*x), B'*x );
+end
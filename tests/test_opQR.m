@@ -58,3 +58,19 @@ function test_opQR_divide_over
    assertElementsAlmostEqual( A * x  , B \ x  );
 
 end
+
+function test_opQR_multiply_rankdeficient
+
+   rng('default');
+
+   % The last column is a combination of the others, so the pivoted
+   % diagonal of R ends with a rounding-level entry instead of zero
+   A = randn(6,3);
+   A = [A, A*[1;2;3]];
+   B = opQR(A);
+   x = randn(6,1);
+
+   % Check opQR against the pseudo-inverse
+   assertElementsAlmostEqual( pinv(A) * x, B * x );
+
+end
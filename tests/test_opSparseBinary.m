@@ -19,3 +19,58 @@ function test_opSparseBinary_against_randn(seed)
    x = randn(n,2);
    assertEqual(  A1*x , A2*x  );
 end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opSparseBinary_pattern(seed)
+   m = 30; n = 45;
+   A = opSparseBinary(m,n,4);
+   S = A.matrix;
+   assertEqual( 4*ones(1,n), full(sum(S,1)) );
+   assertEqual( S, double(A) );
+
+   x = randn(n,3) + 1i*randn(n,3);
+   y = randn(m,3);
+   assertElementsAlmostEqual( S*x,  A*x );
+   assertElementsAlmostEqual( S'*y, A'*y );
+   assertElementsAlmostEqual( S*x(:,1), A*sparse(x(:,1)) );
+
+   % Default number of nonzeros per column
+   assertEqual( [8 n], size(opSparseBinary(m,n).rows) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_opSparseBinary_cost(seed)
+   m = 2000; n = 4000; k = 4;
+   A = opSparseBinary(m,n,8);
+   M = opMatrix(A.matrix);
+   x = randn(n,k);
+   y = randn(m,k);
+
+   % Products keep the sparse matrix that opMatrix holds, and a pattern
+   % of a quarter of its size
+   A*x; A'*y;
+   S = A.counter.cache.matrix;
+   B = M.matrix;
+   rows = A.rows;
+   assertEqual( B, S );
+   infoS = whos('S'); infoB = whos('B'); infoR = whos('rows');
+   assertEqual( infoB.bytes, infoS.bytes );
+   assertTrue( infoR.bytes <= infoS.bytes/4 );
+
+   % and are not slower than those of opMatrix, up to timing noise
+   tA = timeProducts(A,x,y);
+   tM = timeProducts(M,x,y);
+   assertTrue( all(tA <= 1.5*tM + 1e-3) );
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function t = timeProducts(A,x,y)
+% Median times of the forward and adjoint products
+   nrep = 11;
+   t = zeros(nrep,2);
+   for i=1:nrep
+      s = tic; A*x;  t(i,1) = toc(s);
+      s = tic; A'*y; t(i,2) = toc(s);
+   end
+   t = median(t,1);
+end
@@ -106,6 +106,19 @@ function test_opToeplitz_real_scaled
    assertElementsAlmostEqual( A1', double(A2') );
 end
 
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
+function test_opToeplitz_tall_scaled
+   c = 1:9;
+   r = [1 -2 4];
+
+   A1 = toeplitz(c,r);
+   A1 = A1 * spdiags(1./sqrt(sum(A1.^2)'),0,3,3);
+   A2 = opToeplitz(c,r,1);
+
+   assertElementsAlmostEqual( A1, double(A2) );
+   assertElementsAlmostEqual( A1', double(A2') );
+end
+
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  
 function test_opToeplitz_complex
    c = [1:5] + sqrt(-1)*[6:10];
@@ -40,3 +40,27 @@ function test_opiChol_divide
       B \ x  );
 
 end
+
+function test_opiChol_levelsolve
+
+   rng('default');
+
+   % Incomplete factor of a sparse matrix, without refinement
+   A = gallery('poisson',8);
+   L = ichol(A);
+   B = opiChol(A);
+   B.nitref = 0;
+   X = randn(64,4);
+
+   spotparams('levelsolve',true);
+   Y = B * X;
+   spotparams('levelsolve',false);
+
+   assertElementsAlmostEqual( L' \ (L \ X), Y );
+
+   % Schedule of a lower triangular matrix
+   S = spot.utils.levelschedule(L,'lower');
+   assertTrue( S.useful );
+   assertElementsAlmostEqual( L \ X, spot.utils.levelsolve(S,X) );
+
+end
@@ -36,3 +36,58 @@ function test_opiLU_divide
       B \ x  );
 
 end
+
+function test_opiLU_levelsolve
+
+   rng('default');
+
+   % Incomplete factors of a sparse matrix, without refinement
+   A  = gallery('poisson',6) + 0.1*sprandn(36,36,0.05);
+   [L,U] = ilu(A);
+   B  = opiLU(A);
+   B.nitref = 0;
+   X  = randn(36,3);
+
+   spotparams('levelsolve',false);
+   Y1 = B * X;
+   Z1 = B' * X;
+   spotparams('levelsolve',true);
+   Y2 = B * X;
+   Z2 = B' * X;
+   spotparams('levelsolve',false);
+
+   assertElementsAlmostEqual( U \ (L \ X), Y1 );
+   assertElementsAlmostEqual( L' \ (U' \ X), Z1 );
+   assertElementsAlmostEqual( Y1, Y2 );
+   assertElementsAlmostEqual( Z1, Z2 );
+
+   % The adjoint used the solve in mode 2 with the schedules of U'
+   % and L'
+   assertEqual( [2 2], B.nprods );
+   assertTrue( all(isfield(B.counter.cache.levels, {'L','U','Ut','Lt'})) );
+
+end
+
+function test_opiLU_levelsolve_pivoted
+
+   rng('default');
+
+   % With pivoting, ilu returns a row-permutation of a lower triangular
+   % L, for which the level schedule falls back to backslash
+   A  = gallery('poisson',6) + 0.1*sprandn(36,36,0.05);
+   opts = struct('type','ilutp','droptol',1e-2);
+   [L,U] = ilu(A,opts);
+   B  = opiLU(A,opts);
+   B.nitref = 0;
+   X  = randn(36,3);
+
+   spotparams('levelsolve',true);
+   Y = B * X;
+   Z = B' * X;
+   spotparams('levelsolve',false);
+
+   assertElementsAlmostEqual( U \ (L \ X), Y );
+   assertElementsAlmostEqual( L' \ (U' \ X), Z );
+   assertFalse( B.counter.cache.levels.L.useful );
+
+end
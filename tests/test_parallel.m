@@ -0,0 +1,53 @@
+function test_suite = test_parallel
+%test_parallel  Unit tests for concurrent evaluation of child operators
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function teardown(seed)
+   spotparams('parallel','off');
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_parallel_composites(seed)
+   A = opGaussian(20,30);
+   B = opMatrix(randn(20,30));
+   C = opDCT(30);
+   ops = { A + B, [A; B; C], [A, B], blkdiag(A,B,C), ...
+           opBlockOp(8,10,opMatrix(randn(6,8)),4,2,3,2) };
+
+   for i=1:length(ops)
+      op = ops{i};
+      x  = randn(size(op,2),2);
+      y  = randn(size(op,1),2);
+
+      spotparams('parallel','off');
+      y1 = op*x; z1 = op'*y;
+      spotparams('parallel','threads');
+      y2 = op*x; z2 = op'*y;
+
+      assertElementsAlmostEqual(y1,y2);
+      assertElementsAlmostEqual(z1,z2);
+      assertFalse(spot.utils.dottest(op));
+   end
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_parallel_counter(seed)
+   A = opGaussian(10,10);
+   B = opGaussian(10,10);
+   S = A + B;
+   spotparams('parallel','threads');
+   S*randn(10,1);
+   S'*randn(10,1);
+
+   assertEqual([A.counter.mode1 A.counter.mode2],[1 1]);
+   assertEqual([B.counter.timed1 B.counter.timed2],[1 1]);
+   assertTrue(B.counter.cost(1) >= 0);
+end
@@ -64,4 +64,78 @@ end
 
 function y = mfun_wilk(r,n)
    y = r ./ [((n-1)/2:-1:1)'; 1; (1:(n-1)/2)'];
-end
\ No newline at end of file
+end
+
+function test_solves_blocklsqr
+
+   m = 60; n = 40; p = 5;
+   A = randn(m,n); B = randn(m,p); B(:,3) = 0;
+   Aop = opMatrix(A);
+   X1 = A\B;
+
+   [X2,istop,itn] = spot.solvers.lsqr(m,n,Aop,B,0,1e-12,1e-12,1e12,200,0);
+   assertElementsAlmostEqual(X1,X2,'relative',1e-8)
+   assertEqual(X2(:,3),zeros(n,1))
+   assertEqual(itn(3),0)
+   assertTrue(all(istop([1 2 4 5]) > 0))
+
+   % Columns are solved as with the single right-hand side solver
+   x = spot.solvers.lsqr(m,n,Aop,B(:,2),0,1e-12,1e-12,1e12,200,0);
+   assertElementsAlmostEqual(x,X2(:,2),'relative',1e-10)
+
+   % One product per iteration for sweep-capable operators
+   Aop = opMatrix(A);
+   [X3,flag] = lsqr(Aop,B,1e-10,100);
+   assertElementsAlmostEqual(X1,X3,'relative',1e-6)
+   assertEqual(flag,zeros(1,p))
+   assertTrue(all(Aop.nprods <= 101))
+
+   old = {spotparams('cgtol'),spotparams('cgitsfact'),spotparams('cgshow')};
+   cleanup = onCleanup(@() spotparams('cgtol',old{1},'cgitsfact',old{2}, ...
+                                      'cgshow',old{3}));
+   spotparams('cgtol',1e-10,'cgitsfact',3,'cgshow',0);
+   Aop = opFunction(m,n,@(x,mode)afun_matrix(A,x,mode));
+   X4 = Aop\B;
+   assertElementsAlmostEqual(X1,X4,'relative',1e-6)
+
+   % Backslash solves all columns with one product per iteration
+   maxits = 3 * min(m,min(n,20));
+   assertTrue(Aop.nprods(1) <= maxits + 1)
+
+end
+
+function y = afun_matrix(A,x,mode)
+   if mode == 1, y = A*x; else y = A'*x; end
+end
+
+function test_solves_mixedlsqr
+
+   m = 80; n = 50;
+   A = randn(m,n); b = randn(m,1);
+   x1 = A\b;
+
+   Aop = opMatrix(A);
+   [x2,istop] = spot.solvers.mplsqr(m,n,Aop,b,0,1e-12,1e-12,1e12,500,0);
+   assertElementsAlmostEqual(x1,x2,'relative',1e-8)
+   assertTrue(istop > 0 && istop < 7)
+   assertTrue(isa(x2,'double'))
+   assertEqual(single(A),Aop.counter.cache.singlematrix)
+
+   % Operators that cannot work in single precision fall back to LSQR
+   Aop = opFunction(m,n,@(x,mode)afun_double(A,x,mode));
+   x3 = spot.solvers.mplsqr(m,n,Aop,b,0,1e-12,1e-12,1e12,500,0);
+   assertElementsAlmostEqual(x1,x3,'relative',1e-8)
+   assertFalse(Aop.counter.cache.single)
+
+   spotparams('cgprecision','mixed','cgtol',1e-10,'cgitsfact',10);
+   Aop = opFunction(m,n,@(x,mode)afun_matrix(A,x,mode));
+   x4 = Aop\b;
+   spotparams('default');
+   assertElementsAlmostEqual(x1,x4,'relative',1e-6)
+
+end
+
+function y = afun_double(A,x,mode)
+   if ~isa(x,'double'), error('Double precision input expected.'); end
+   if mode == 1, y = A*x; else y = A'*x; end
+end
@@ -0,0 +1,34 @@
+function test_suite = test_spotbench
+%test_spotbench  Unit tests for the benchmark suite
+initTestSuite;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function seed = setup
+   rng('default');
+   seed = [];
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function test_spotbench_output(seed)
+   json = [tempname '.json'];
+   csv  = [tempname '.csv'];
+   args = {'operators',{'opDCT','opWavelet2'},'sizes',256, ...
+           'levels',2,'filters',4,'rhs',[1 2],'warmup',0,'repeat',2, ...
+           'verbose',false};
+
+   r = spotbench(args{:},'output',json);
+   assertEqual(length(r),8);
+   assertEqual(sort(unique({r.mode})),{'adjoint','forward'});
+   assertTrue(all([r.time] > 0));
+
+   % Compare against the stored run; a huge threshold flags nothing.
+   s = spotbench(args{:},'baseline',json,'threshold',1e6,'output',csv);
+   assertEqual([s.baseline],[r.time]);
+   assertFalse(any([s.regression]));
+
+   lines = strsplit(strtrim(fileread(csv)),sprintf('\n'));
+   assertEqual(length(lines),9);
+
+   delete(json); delete(csv);
+end
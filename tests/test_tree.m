@@ -125,4 +125,37 @@ function test_tree_concatentation(d)
       title(['Post-optimized flops: ', num2str(postFlops)])
    end
    assertElementsAlmostEqual(double(B5),double(C5))
-end
\ No newline at end of file
+end
+
+function test_tree_profile(d)
+   import spot.utils.*
+   B = d.A1*(d.A2 + d.A2)*d.A3;
+   x = randn(5,3);
+   spotparams('profile',true);
+   y = B*x;
+   z = B'*y;
+   spotparams('profile',false);
+   assertElementsAlmostEqual(y,double(B)*x)
+
+   s = report(spottree(B));
+   assertEqual(s(1).depth,0)
+   assertEqual(s(1).products,[1 1])
+   assertEqual(s(1).columns,[3 3])
+   assertEqual(s(1).bytesin,8*(5*3 + 30*3))
+   assertTrue(s(1).inclusive >= sum([s([s.depth] == 1).inclusive]) - 1e-12)
+   assertTrue(all([s.exclusive] >= 0))
+
+   % The two occurrences of A2 share a counter that covers both, and
+   % it is subtracted once from the exclusive time of the sum
+   i = find(strncmp({s.label},'Sum',3));
+   assertEqual(numel(i),1)
+   assertEqual(s(i+1).inclusive,s(i+2).inclusive)
+   assertEqual(s(i).exclusive,s(i).inclusive - s(i+1).inclusive)
+   assertTrue(s(i).exclusive >= 0)
+
+   % Nothing is recorded when profiling is off
+   d.A4.counter.reset();
+   w = d.A4*randn(10,1);
+   assertEqual(d.A4.counter.timed1,0)
+   assertEqual(d.A4.counter.mode1,1)
+end